@@ -0,0 +1,39 @@
+project "SympleBench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+	
+	defines {
+		"SY_32"
+		-- "SY_64"
+	}
+	
+	-- Builds the compiler sources in, minus its entry point
+	files {
+		"src/**.cpp",
+		
+		"%{wks.location}/SympleLang/inc/**.h",
+		"%{wks.location}/SympleLang/inc/**.hpp",
+		"%{wks.location}/SympleLang/src/**.cpp"
+	}
+	
+	removefiles {
+		"%{wks.location}/SympleLang/src/Main.cpp"
+	}
+	
+	includedirs {
+		"%{wks.location}/SympleLang/inc",
+		
+		"%{wks.location}/SympleLang/vendor/spdlog/include"
+	}
+	
+	filter "configurations:Debug"
+		defines "__SY_DEBUG"
+		symbols "On"
+
+	filter "configurations:Release"
+		defines "__SY_RELEASE"
+		optimize "On"
@@ -0,0 +1,324 @@
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "SympleCode/Syntax/Lexer.h"
+#include "SympleCode/Syntax/Parser.h"
+#include "SympleCode/Util/Scan.h"
+
+#if _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Symple;
+
+#pragma region Allocation Tracking
+
+// Every allocation is prefixed with its size so frees can be tracked too
+static constexpr size_t sHeaderSize = alignof(std::max_align_t);
+
+static std::atomic<size_t> sAllocations, sAllocatedBytes, sLiveBytes, sPeakLiveBytes;
+
+void* operator new(size_t sz)
+{
+	char* block = (char*)malloc(sz + sHeaderSize);
+	if (!block)
+		throw std::bad_alloc();
+	*(size_t*)block = sz;
+
+	sAllocations++;
+	sAllocatedBytes += sz;
+	size_t live = sLiveBytes += sz;
+	size_t peak = sPeakLiveBytes;
+	while (live > peak && !sPeakLiveBytes.compare_exchange_weak(peak, live));
+
+	return block + sHeaderSize;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	if (!ptr)
+		return;
+	char* block = (char*)ptr - sHeaderSize;
+	sLiveBytes -= *(size_t*)block;
+	free(block);
+}
+
+void* operator new[](size_t sz)
+{ return operator new(sz); }
+
+void operator delete[](void* ptr) noexcept
+{ operator delete(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept
+{ operator delete(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept
+{ operator delete(ptr); }
+
+// Highest resident set of the whole process so far, not of any one phase
+static size_t GetPeakRSS()
+{
+#if _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize;
+	return 0;
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (size_t)usage.ru_maxrss * 1024;
+#endif
+}
+
+#pragma endregion
+
+#pragma region Corpora
+
+typedef void (*CorpusGenerator)(std::string&, unsigned index);
+
+// Many small functions with a few statements each
+static void GenerateFunctions(std::string& src, unsigned i)
+{
+	std::string n = std::to_string(i);
+	src += "int Func" + n + "(int a, int b = " + n + ")\n{\n";
+	src += "\tint c = a + b;\n";
+	src += "\tc = c * 2 - a;\n";
+	src += "\tret Func" + n + "(c, b);\n}\n\n";
+}
+
+// Few functions each returning one deeply nested expression
+static void GenerateExpressions(std::string& src, unsigned i)
+{
+	constexpr unsigned depth = 64;
+
+	std::string expr = "x";
+	for (unsigned d = 0; d < depth; d++)
+		expr = '(' + expr + (d % 2 ? " * " : " + ") + std::to_string(d + i) + ')';
+	src += "int Expr" + std::to_string(i) + "(int x)\n{\n\tret " + expr + ";\n}\n\n";
+}
+
+// Functions that pass long string literals
+static void GenerateStrings(std::string& src, unsigned i)
+{
+	constexpr unsigned length = 4096;
+
+	src += "int Str" + std::to_string(i) + "()\n{\n\tputs(\"";
+	for (unsigned c = 0; c < length; c++)
+		src += (char)('a' + (c + i) % 26);
+	src += "\");\n\tret 0;\n}\n\n";
+}
+
+// Nothing but import statements
+static void GenerateImports(std::string& src, unsigned i)
+{ src += "import \"inc/Module" + std::to_string(i) + ".sy\";\n"; }
+
+struct Corpus
+{
+	char* Name;
+	CorpusGenerator Generate;
+};
+
+static Corpus sCorpora[] = {
+	{ "functions", GenerateFunctions },
+	{ "expressions", GenerateExpressions },
+	{ "strings", GenerateStrings },
+	{ "imports", GenerateImports },
+};
+
+static std::string GenerateCorpus(Corpus& corpus, unsigned size)
+{
+	std::string src;
+	src.reserve(size + 8192);
+	for (unsigned i = 0; src.length() < size; i++)
+		corpus.Generate(src, i);
+	return src;
+}
+
+#pragma endregion
+
+#pragma region Measuring
+
+struct Measurement
+{
+	double Seconds = 0;
+	unsigned Tokens = 0;
+	size_t Allocations = 0, AllocatedBytes = 0, PeakLiveBytes = 0;
+};
+
+// Runs the phase repeat times and keeps the fastest run
+template<typename F>
+static Measurement Measure(unsigned repeat, F phase)
+{
+	Measurement best;
+	for (unsigned r = 0; r < repeat; r++)
+	{
+		size_t allocations = sAllocations, allocatedBytes = sAllocatedBytes;
+		size_t liveBefore = sLiveBytes;
+		sPeakLiveBytes = liveBefore;
+
+		auto start = std::chrono::steady_clock::now();
+		unsigned tokens = phase();
+		std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+		if (!r || time.count() < best.Seconds)
+		{
+			best.Seconds = time.count();
+			best.Tokens = tokens;
+			best.Allocations = sAllocations - allocations;
+			best.AllocatedBytes = sAllocatedBytes - allocatedBytes;
+			best.PeakLiveBytes = sPeakLiveBytes - liveBefore;
+		}
+	}
+	return best;
+}
+
+static void Report(char* corpus, size_t bytes, char* phase, char* scan, Measurement& m)
+{
+	printf("{\"corpus\": \"%s\", \"bytes\": %zu, \"phase\": \"%s\", \"scan\": \"%s\", \"tokens\": %u, \"seconds\": %.9f, "
+		"\"bytes_per_sec\": %.0f, \"tokens_per_sec\": %.0f, \"allocations\": %zu, \"allocated_bytes\": %zu, \"peak_live_bytes\": %zu, \"process_peak_rss\": %zu}\n",
+		corpus, bytes, phase, scan, m.Tokens, m.Seconds,
+		bytes / m.Seconds, m.Tokens / m.Seconds, m.Allocations, m.AllocatedBytes, m.PeakLiveBytes, GetPeakRSS());
+	fflush(stdout);
+}
+
+static shared_ptr<Syntax::TokenBuffer> LexAll(shared_ptr<Util::MappedFile> source)
+{
+	auto lexer = make_shared<Syntax::Lexer>((char*)"bench.sy", source);
+	while (!lexer->Lex().Is(Syntax::Token::EndOfFile));
+	return lexer->GetTokens();
+}
+
+#pragma endregion
+
+static bool EqualsIgnoreCase(const char* a, const char* b)
+{
+	for (; *a && *b; a++, b++)
+		if (tolower((unsigned char)*a) != tolower((unsigned char)*b))
+			return false;
+	return *a == *b;
+}
+
+static void PrintUsage()
+{
+	puts("Usage: SympleBench [--size bytes]... [--corpus name]... [--repeat n] [--scan scalar|sse2|avx2|all]");
+	puts("Prints one JSON object per line for each corpus, size and phase");
+	puts("process_peak_rss is the high-water mark of the whole run up to that line, not of the phase");
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<unsigned> sizes;
+	std::vector<Corpus*> corpora;
+	unsigned repeat = 5;
+	std::vector<Util::ScanLevel> scanLevels = { Util::GetSupportedScanLevel() };
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+		if (!strcmp(argv[i], "--size") && hasValue)
+			sizes.push_back(strtoul(argv[++i], nullptr, 0));
+		else if (!strcmp(argv[i], "--repeat") && hasValue)
+			repeat = std::max(1ul, strtoul(argv[++i], nullptr, 0));
+		else if (!strcmp(argv[i], "--corpus") && hasValue)
+		{
+			char* name = argv[++i];
+			Corpus* found = nullptr;
+			for (auto& corpus : sCorpora)
+				if (!strcmp(corpus.Name, name))
+					found = &corpus;
+			if (!found)
+			{
+				fprintf(stderr, "Unknown corpus '%s'\n", name);
+				return 1;
+			}
+			corpora.push_back(found);
+		}
+		else if (!strcmp(argv[i], "--scan") && hasValue)
+		{
+			char* name = argv[++i];
+			scanLevels.clear();
+			for (unsigned level = Util::ScalarScan; level <= Util::GetSupportedScanLevel(); level++)
+				if (!strcmp(name, "all") || EqualsIgnoreCase(name, Util::GetScanLevelName((Util::ScanLevel)level)))
+					scanLevels.push_back((Util::ScanLevel)level);
+			if (scanLevels.empty())
+			{
+				fprintf(stderr, "Scan level '%s' is unknown or unsupported\n", name);
+				return 1;
+			}
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (sizes.empty())
+		sizes = { 64 << 10, 1 << 20, 16 << 20 };
+	if (corpora.empty())
+		for (auto& corpus : sCorpora)
+			corpora.push_back(&corpus);
+
+	spdlog::set_level(spdlog::level::off);
+
+	for (auto corpus : corpora)
+		for (unsigned size : sizes)
+		{
+			auto source = make_shared<Util::MappedFile>(GenerateCorpus(*corpus, size));
+
+			for (auto level : scanLevels)
+			{
+				Util::SetScanLevel(level);
+				char* scan = Util::GetScanLevelName(level);
+
+				Measurement lex = Measure(repeat, [&]() { return LexAll(source)->GetCount(); });
+				Report(corpus->Name, source->GetSize(), "lex", scan, lex);
+
+				Measurement lexParallel = Measure(repeat, [&]()
+					{
+						auto lexer = make_shared<Syntax::Lexer>((char*)"bench.sy", source);
+						return lexer->LexParallel() ? lexer->GetTokens()->GetCount() : 0;
+					});
+				if (lexParallel.Tokens)
+					Report(corpus->Name, source->GetSize(), "lex-parallel", scan, lexParallel);
+			}
+
+			auto tokens = LexAll(source);
+			Measurement parse = Measure(repeat, [&]()
+				{
+					Syntax::Parser parser(tokens);
+					parser.Parse();
+					return tokens->GetCount();
+				});
+			Report(corpus->Name, source->GetSize(), "parse", "", parse);
+
+			// Inserts a space in the middle of the file and takes it back out on the next run
+			auto tree = Syntax::Parser(tokens).Parse();
+			unsigned middle = source->GetSize() / 2;
+			bool inserted = false;
+			Measurement reparse = Measure(repeat, [&]()
+				{
+					Syntax::TextEdit edit = { middle, inserted, inserted ? "" : " " };
+					tree = Syntax::Parser(tree, edit).Parse();
+					inserted = !inserted;
+					return tree->GetTokens().back()->GetCount();
+				});
+			Report(corpus->Name, source->GetSize(), "reparse", "", reparse);
+		}
+
+	return 0;
+}
@@ -3,6 +3,7 @@
 #include <unordered_map>
 
 #include "SympleCode/DiagnosticBag.h"
+#include "SympleCode/CompilationContext.h"
 
 #include "SympleCode/Syntax/TypeSyntax.h"
 #include "SympleCode/Syntax/ImportStatementSyntax.h"
@@ -21,8 +22,9 @@
 #include "SympleCode/Symbol/StructTypeSymbol.h"
 
 #include "SympleCode/Binding/Node.h"
-#include "SympleCode/Binding/BoundScope.h"
+#include "SympleCode/Symbol/SymbolTable.h"
 #include "SympleCode/Binding/BoundCompilationUnit.h"
+#include "SympleCode/Binding/SymbolCache.h"
 
 #include "SympleCode/Binding/BoundLabel.h"
 #include "SympleCode/Binding/BoundStatement.h"
@@ -48,30 +50,49 @@ namespace Symple::Binding
 	class Binder
 	{
 	private:
-		static std::unordered_map<std::string, shared_ptr<BoundCompilationUnit>> sImportedSymbols;
+		shared_ptr<CompilationContext> mContext;
 		shared_ptr<Syntax::TranslationUnitSyntax> mCompilationUnit;
-		StructMap mStructures;
-		FunctionMap mFunctions;
-		Symbol::LabelList mLabels;
-		std::vector<shared_ptr<GotoPromise>> mGotoPromises;
-		std::vector<shared_ptr<MemberPromise>> mMemPromises;
-		std::vector<shared_ptr<FunctionPromise>> mFuncPromises;
-
-		shared_ptr<BoundScope> mScope;
+		// Shared with the binders of function bodies, which only read them
+		shared_ptr<StructMap> mStructures = make_shared<StructMap>();
+		shared_ptr<FunctionMap> mFunctions = make_shared<FunctionMap>();
+		// Of the function or global statement being bound, collected before it so gotos resolve as they're bound
+		std::unordered_map<Util::Atom, shared_ptr<Symbol::LabelSymbol>> mLabels;
+		// Every import statement, in order
+		std::vector<SymbolCache::Import> mImports;
+
+		Symbol::SymbolTable mScope;
 		shared_ptr<DiagnosticBag> mDiagnosticBag = make_shared<DiagnosticBag>();
 
+		// A function whose body is bound after every declaration
+		struct FunctionBody
+		{
+			shared_ptr<Syntax::FunctionDeclarationSyntax> Declaration;
+			shared_ptr<Symbol::FunctionSymbol> Function;
+			unsigned Index;
+			// Global variables declared before it
+			shared_ptr<Symbol::SymbolTable> Globals;
+			// Of the member, the body's are added to it
+			shared_ptr<DiagnosticBag> Diagnostics;
+		};
+
+		// Binds a body on top of the globals without copying them, they must outlive it
+		Binder(Binder& parent, const Symbol::SymbolTable& globals);
+
 		void BeginScope();
 		void EndScope();
 
-		void CheckGotoPromises();
-		void CheckMemberPromises();
-		void CheckFunctionPromises();
+		void BindFunctionBodies(std::vector<FunctionBody>&);
+		// Every label in a statement and the ones inside it
+		void DeclareLabels(shared_ptr<Syntax::StatementSyntax>);
 
 		shared_ptr<Node> BindMemberInternal(shared_ptr<Syntax::MemberSyntax>);
 		shared_ptr<BoundStatement> BindStatementInternal(shared_ptr<Syntax::StatementSyntax>);
 		shared_ptr<BoundExpression> BindExpressionInternal(shared_ptr<Syntax::ExpressionSyntax>);
 	public:
+		Binder(shared_ptr<CompilationContext>);
+
 		shared_ptr<BoundCompilationUnit> BindImport(shared_ptr<Syntax::ImportStatementSyntax>);
+		shared_ptr<BoundCompilationUnit> BindImport(std::string path, std::string_view name, shared_ptr<Syntax::Node> syntax = nullptr);
 		shared_ptr<BoundCompilationUnit> BindSymbols(shared_ptr<Syntax::TranslationUnitSyntax>);
 		shared_ptr<BoundCompilationUnit> Bind(shared_ptr<Syntax::TranslationUnitSyntax>);
 		shared_ptr<Symbol::Symbol> BindMemberSymbol(shared_ptr<Syntax::MemberSyntax>);
@@ -81,6 +102,9 @@ namespace Symple::Binding
 		shared_ptr<Symbol::LabelSymbol> BindLabelSymbol(shared_ptr<Syntax::LabelSyntax>);
 		shared_ptr<Symbol::MemberSymbol> BindMember(shared_ptr<Syntax::VariableDeclarationSyntax>);
 		shared_ptr<Symbol::FunctionSymbol> BindFunction(shared_ptr<Syntax::FunctionDeclarationSyntax>);
+		// Just the signature
+		shared_ptr<Symbol::FunctionSymbol> BindFunctionSymbol(shared_ptr<Syntax::FunctionDeclarationSyntax>);
+		shared_ptr<BoundStatement> BindFunctionBody(shared_ptr<Symbol::FunctionSymbol>, shared_ptr<Syntax::StatementSyntax>);
 		shared_ptr<Symbol::FunctionSymbol> BindExternFunction(shared_ptr<Syntax::ExternFunctionSyntax>);
 		shared_ptr<Symbol::ParameterSymbol> BindParameter(shared_ptr<Syntax::VariableDeclarationSyntax>);
 		shared_ptr<Symbol::StructTypeSymbol> BindStructType(shared_ptr<Syntax::StructDeclarationSyntax>);
@@ -104,5 +128,9 @@ namespace Symple::Binding
 		shared_ptr<BoundExpression> BindNameExpression(shared_ptr<Syntax::NameExpressionSyntax>);
 
 		shared_ptr<DiagnosticBag> GetDiagnosticBag();
+		std::vector<SymbolCache::Import>& GetImports();
+
+		// Relative to the importing file
+		static std::string GetImportPath(shared_ptr<Syntax::ImportStatementSyntax>);
 	};
 }
\ No newline at end of file
@@ -19,7 +19,8 @@ namespace Symple::Binding
 		bool mMutable;
 
 		BoundBinaryOperator(Syntax::Token::Kind, Kind, shared_ptr<Symbol::TypeSymbol> leftType, shared_ptr<Symbol::TypeSymbol> rightType, shared_ptr<Symbol::TypeSymbol> type, bool isMutable = false);
-		static std::vector<shared_ptr<BoundBinaryOperator>> sOperators;
+		// One of each, in the order of the table in the source
+		static std::vector<shared_ptr<BoundBinaryOperator>>& GetOperators();
 	public:
 		void Print(std::ostream& = std::cout, std::string_view indent = "", bool last = true, std::string_view label = "");
 		void PrintShort(std::ostream& os = std::cout);
@@ -8,15 +8,14 @@
 
 namespace Symple::Binding
 {
-	typedef Promise<std::pair<shared_ptr<Symbol::FunctionSymbol>, ExpressionList>, shared_ptr<Syntax::CallExpressionSyntax>> FunctionPromise;
-
 	class BoundCallExpression : public BoundExpression
 	{
 	private:
-		shared_ptr<FunctionPromise> mFunction;
+		shared_ptr<Symbol::FunctionSymbol> mFunction;
+		ExpressionList mArguments;
 	public:
-		BoundCallExpression(shared_ptr<Syntax::CallExpressionSyntax> syntax, shared_ptr<FunctionPromise> func)
-			: BoundExpression(syntax), mFunction(func) {}
+		BoundCallExpression(shared_ptr<Syntax::CallExpressionSyntax> syntax, shared_ptr<Symbol::FunctionSymbol> func, ExpressionList args)
+			: BoundExpression(syntax), mFunction(func), mArguments(args) {}
 
 		virtual Kind GetKind() override
 		{ return CallExpression; }
@@ -29,7 +28,7 @@ namespace Symple::Binding
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 
-			//os << " '" << GetSyntax()->GetToken()->GetText(); os << '(' << (GetArguments().size()) << ")'";
+			//os << " '" << GetSyntax()->GetToken().GetText(); os << '(' << (GetArguments().size()) << ")'";
 			
 			std::string newIndent(indent);
 			newIndent += GetAddIndent(last);
@@ -39,9 +38,9 @@ namespace Symple::Binding
 		}
 
 		shared_ptr<Symbol::FunctionSymbol> GetFunction()
-		{ return mFunction->GetObject().first; }
+		{ return mFunction; }
 
 		ExpressionList GetArguments()
-		{ return mFunction->GetObject().second; }
+		{ return mArguments; }
 	};
 }
\ No newline at end of file
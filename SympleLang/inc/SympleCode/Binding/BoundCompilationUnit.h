@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <unordered_map>
 
 #include "SympleCode/Syntax/TranslationUnitSyntax.h"
 
@@ -12,24 +13,89 @@
 
 namespace Symple::Binding
 {
-	typedef std::vector<shared_ptr<Symbol::StructTypeSymbol>> StructMap;
-	typedef std::vector<std::pair<shared_ptr<Symbol::FunctionSymbol>, shared_ptr<BoundStatement>>> FunctionMap;
-
-	inline shared_ptr<Symbol::StructTypeSymbol> FindStruct(StructMap structs, std::string_view name)
+	// Structures in declaration order, indexed by name
+	class StructMap
 	{
-		for (auto s : structs)
-			if (s->GetName() == name)
-				return s;
-		return nullptr;
-	}
+	private:
+		std::vector<shared_ptr<Symbol::StructTypeSymbol>> mStructures;
+		std::unordered_map<Util::Atom, shared_ptr<Symbol::StructTypeSymbol>> mIndex;
+	public:
+		void push_back(shared_ptr<Symbol::StructTypeSymbol> s)
+		{
+			mStructures.push_back(s);
+			// The first declaration wins, like a front to back search would
+			mIndex.insert({ s->GetAtom(), s });
+		}
 
-	inline shared_ptr<Symbol::FunctionSymbol> FindFunction(FunctionMap funcs, std::string_view name)
+		void clear()
+		{
+			mStructures.clear();
+			mIndex.clear();
+		}
+
+		shared_ptr<Symbol::StructTypeSymbol> Find(Util::Atom name)
+		{
+			auto s = mIndex.find(name);
+			return s == mIndex.end() ? nullptr : s->second;
+		}
+
+		auto begin()
+		{ return mStructures.begin(); }
+
+		auto end()
+		{ return mStructures.end(); }
+	};
+
+	// Functions and their bodies in declaration order, indexed by name. Every declaration of a name is kept in its
+	// bucket so overloads can be told apart later, for now the first one is the one that's found
+	class FunctionMap
 	{
-		for (auto fn : funcs)
-			if (fn.first->GetName() == name)
-				return fn.first;
-		return nullptr;
-	}
+	public:
+		typedef std::pair<shared_ptr<Symbol::FunctionSymbol>, shared_ptr<BoundStatement>> Entry;
+	private:
+		std::vector<Entry> mFunctions;
+		std::unordered_map<Util::Atom, Symbol::FunctionList> mIndex;
+	public:
+		void push_back(Entry fn)
+		{
+			mFunctions.push_back(fn);
+			mIndex[fn.first->GetAtom()].push_back(fn.first);
+		}
+
+		void clear()
+		{
+			mFunctions.clear();
+			mIndex.clear();
+		}
+
+		shared_ptr<Symbol::FunctionSymbol> Find(Util::Atom name)
+		{
+			auto bucket = mIndex.find(name);
+			return bucket == mIndex.end() ? nullptr : bucket->second.front();
+		}
+
+		// Every function declared with this name, empty if there are none
+		Symbol::FunctionList FindAll(Util::Atom name)
+		{
+			auto bucket = mIndex.find(name);
+			return bucket == mIndex.end() ? Symbol::FunctionList() : bucket->second;
+		}
+
+		Entry& back()
+		{ return mFunctions.back(); }
+
+		Entry& operator [](unsigned i)
+		{ return mFunctions[i]; }
+
+		unsigned size()
+		{ return mFunctions.size(); }
+
+		auto begin()
+		{ return mFunctions.begin(); }
+
+		auto end()
+		{ return mFunctions.end(); }
+	};
 
 	class BoundCompilationUnit : public Node
 	{
@@ -38,7 +104,7 @@ namespace Symple::Binding
 		FunctionMap mFunctions;
 	public:
 		BoundCompilationUnit(shared_ptr<Syntax::Node> syntax, StructMap structs, FunctionMap funcs)
-			: Node(syntax), mStructures(structs), mFunctions(funcs) {}
+			: Node(syntax), mStructures(std::move(structs)), mFunctions(std::move(funcs)) {}
 
 		virtual Kind GetKind() override
 		{ return CompilationUnit; }
@@ -62,10 +128,10 @@ namespace Symple::Binding
 			}
 		}
 
-		StructMap GetStructures()
+		StructMap& GetStructures()
 		{ return mStructures; }
 
-		FunctionMap GetFunctions()
+		FunctionMap& GetFunctions()
 		{ return mFunctions; }
 	};
 }
\ No newline at end of file
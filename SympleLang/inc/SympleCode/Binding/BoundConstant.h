@@ -58,6 +58,13 @@ namespace Symple::Binding
 			}
 		}
 
+		bool Equals(shared_ptr<BoundConstant> other)
+		{
+			if (!other || GetKind() != other->GetKind())
+				return false;
+			return GetKind() == Float ? GetValue<float>() == other->GetValue<float>() : GetValue<int>() == other->GetValue<int>();
+		}
+
 		void SetKind(Kind kind)
 		{ mKind = kind; }
 
@@ -4,20 +4,18 @@
 
 #include "SympleCode/Binding/BoundExpression.h"
 
-#include "SympleCode/Symbol/Promise.h"
 #include "SympleCode/Symbol/MemberSymbol.h"
 
 namespace Symple::Binding
 {
-	typedef Promise<shared_ptr<Symbol::MemberSymbol>, std::pair<shared_ptr<BoundExpression>, shared_ptr<Syntax::BinaryExpressionSyntax>>> MemberPromise;
-
 	class BoundFieldExpression: public BoundExpression
 	{
 	private:
-		shared_ptr<MemberPromise> mMember;
+		shared_ptr<BoundExpression> mOperand;
+		shared_ptr<Symbol::MemberSymbol> mMember;
 	public:
-		BoundFieldExpression(shared_ptr<Syntax::BinaryExpressionSyntax> syntax, shared_ptr<MemberPromise> member)
-			: BoundExpression(syntax), mMember(member) {}
+		BoundFieldExpression(shared_ptr<Syntax::BinaryExpressionSyntax> syntax, shared_ptr<BoundExpression> operand, shared_ptr<Symbol::MemberSymbol> member)
+			: BoundExpression(syntax), mOperand(operand), mMember(member) {}
 
 		virtual Kind GetKind() override
 		{ return FieldExpression; }
@@ -43,9 +41,9 @@ namespace Symple::Binding
 		}
 
 		shared_ptr<BoundExpression> GetOperand()
-		{ return mMember->GetPrompt().first; }
+		{ return mOperand; }
 
 		shared_ptr<Symbol::MemberSymbol> GetMember()
-		{ return mMember->GetObject(); }
+		{ return mMember; }
 	};
 }
\ No newline at end of file
@@ -4,19 +4,16 @@
 
 #include "SympleCode/Binding/BoundStatement.h"
 
-#include "SympleCode/Symbol/Promise.h"
 #include "SympleCode/Symbol/LabelSymbol.h"
 
 namespace Symple::Binding
 {
-	typedef Promise<shared_ptr<Symbol::LabelSymbol>, shared_ptr<Syntax::GotoStatementSyntax>> GotoPromise;
-
 	class BoundGotoStatement : public BoundStatement
 	{
 	private:
-		shared_ptr<GotoPromise> mLabel;
+		shared_ptr<Symbol::LabelSymbol> mLabel;
 	public:
-		BoundGotoStatement(shared_ptr<Syntax::GotoStatementSyntax> syntax, shared_ptr<GotoPromise> symbol)
+		BoundGotoStatement(shared_ptr<Syntax::GotoStatementSyntax> syntax, shared_ptr<Symbol::LabelSymbol> symbol)
 			: BoundStatement(syntax), mLabel(symbol)
 		{}
 
@@ -34,6 +31,6 @@ namespace Symple::Binding
 		{ return mLabel; }
 
 		std::string_view GetLabel()
-		{ return mLabel->GetPrompt()->GetToken()->GetText(); }
+		{ return GetSyntax()->GetToken().GetText(); }
 	};
 }
\ No newline at end of file
@@ -24,6 +24,6 @@ namespace Symple::Binding
 		}
 
 		std::string_view GetAssembly()
-		{ return dynamic_pointer_cast<Syntax::NativeStatementSyntax>(GetSyntax())->GetAssembly()->GetText(); }
+		{ return dynamic_pointer_cast<Syntax::NativeStatementSyntax>(GetSyntax())->GetAssembly().GetText(); }
 	};
 }
\ No newline at end of file
@@ -18,7 +18,8 @@ namespace Symple::Binding
 		shared_ptr<Symbol::TypeSymbol> mOperandType, mType;
 
 		BoundUnaryOperator(Syntax::Token::Kind, Kind, shared_ptr<Symbol::TypeSymbol> operandType, shared_ptr<Symbol::TypeSymbol> type);
-		static std::vector<shared_ptr<BoundUnaryOperator>> sOperators;
+		// One of each, in the order of the table in the source
+		static std::vector<shared_ptr<BoundUnaryOperator>>& GetOperators();
 	public:
 		void Print(std::ostream& = std::cout, std::string_view indent = "", bool last = true, std::string_view label = "");
 		void PrintShort(std::ostream& os = std::cout);
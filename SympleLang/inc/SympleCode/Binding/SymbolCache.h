@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "SympleCode/Binding/BoundConstant.h"
+#include "SympleCode/Binding/BoundCompilationUnit.h"
+#include "SympleCode/CompilationContext.h"
+
+namespace Symple::Binding
+{
+	// Binary interface of an imported file, the structures and function signatures it exports and the files it imports.
+	// Entries are keyed by the hash of the source and the keys of what it imports, so a change anywhere below it is
+	// noticed, and checked against their own hash. Anything from another version or that is cut short is ignored.
+	// The keys of imports come from the compilation context rather than their entries, which may not be written yet
+	class __SYC_API SymbolCache
+	{
+	public:
+		struct Import
+		{
+			std::string Path;
+			std::string Name;
+		};
+	private:
+		static constexpr char sMagic[4] = { 'S', 'Y', 'S', 'I' };
+		static constexpr unsigned sVersion = 1;
+
+		std::string mData;
+		unsigned mPosition = 0;
+		bool mFailed = false;
+
+		// A type as it's stored, structures are referred to by index
+		struct TypeEntry
+		{
+			Symbol::TypeSymbol::TypeKind Kind;
+			unsigned Structure, PointerCount;
+		};
+
+		// A member or parameter
+		struct VariableEntry
+		{
+			TypeEntry Type;
+			std::string Name;
+			shared_ptr<BoundConstant> Initializer;
+		};
+
+		// Written so far, types refer to them by index
+		std::vector<shared_ptr<Symbol::StructTypeSymbol>> mStructures;
+		// Read so far, a type can only refer to these
+		unsigned mStructureCount = 0;
+
+		template<typename T>
+		void Write(T);
+		void Write(std::string_view);
+		void Write(shared_ptr<Symbol::TypeSymbol>);
+		void Write(shared_ptr<BoundConstant>);
+
+		template<typename T>
+		T Read();
+		std::string ReadString();
+		TypeEntry ReadType();
+		VariableEntry ReadVariable();
+		void ReadImports(std::vector<Import>&);
+		shared_ptr<BoundConstant> ReadConstant();
+
+		// Symbols are only made once the whole entry is read, so nothing is interned from one that turns out unusable
+		static shared_ptr<Symbol::TypeSymbol> MakeType(TypeEntry&, std::vector<shared_ptr<Symbol::StructTypeSymbol>>& structs, shared_ptr<CompilationContext>);
+
+		// Reads a whole entry and checks its header, fills key with the one it was stored under
+		bool ReadFile(char* path, uint64_t& key);
+	public:
+		// Null if there's no usable entry for this exact source and its imports. Whatever it imported is imported
+		// again first, into the given context, which brings their own entries up to date and gives this file its key
+		static shared_ptr<BoundCompilationUnit> Load(char* path, char* file, shared_ptr<CompilationContext>);
+		// Replaces the entry whole, so it's never read half written
+		static bool Store(char* path, char* file, shared_ptr<BoundCompilationUnit>, std::vector<Import>& imports, shared_ptr<CompilationContext>);
+		// Of a source and the keys its imports have in the context, 0 if one of them has none
+		static uint64_t GetKey(char* file, std::vector<Import>& imports, shared_ptr<CompilationContext>);
+		// What an entry was made importing, without checking whether it's still usable
+		static bool LoadImports(char* path, std::vector<Import>& imports);
+	};
+}
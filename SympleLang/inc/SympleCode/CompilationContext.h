@@ -0,0 +1,80 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <future>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "SympleCode/Binding/BoundCompilationUnit.h"
+
+namespace Symple
+{
+	// Everything the files of one program share while it's compiled, what they've imported and what gets linked.
+	// Contexts share nothing mutable, so separate programs can be compiled in one process at the same time
+	class __SYC_API CompilationContext
+	{
+	private:
+		std::unordered_map<std::string, shared_ptr<Binding::BoundCompilationUnit>> mImportedSymbols;
+		// Symbol cache key of each imported file, known as soon as its declarations are
+		std::unordered_map<std::string, uint64_t> mKeys;
+
+		struct StructKey
+		{
+			Util::Atom File, Name;
+
+			bool operator ==(const StructKey& other) const
+			{ return File == other.File && Name == other.Name; }
+		};
+
+		struct StructKeyHash
+		{
+			size_t operator ()(const StructKey& key) const
+			{ return key.File.GetId() * 31 + key.Name.GetId(); }
+		};
+
+		// The latest declaration of each struct by file and name, see InternStruct
+		std::unordered_map<StructKey, shared_ptr<Symbol::StructTypeSymbol>, StructKeyHash> mStructs;
+		// Pointer types by base and pointer count. Entries don't keep them alive, a pointer type holds on to its base,
+		// so a live entry's key can't be reused
+		std::map<std::pair<Symbol::TypeSymbol*, unsigned>, std::weak_ptr<Symbol::TypeSymbol>> mPointers;
+		// Size the pointer table is pruned of expired entries at
+		size_t mPruneSize = 64;
+		std::vector<std::string> mLibraries;
+		std::vector<std::string> mUnits;
+		// Imports still being compiled, whether each one succeeded
+		std::vector<std::future<bool>> mPending;
+		// Files can be imported and types made from any thread
+		std::mutex mMutex;
+	public:
+		CompilationContext();
+
+		CompilationContext(const CompilationContext&) = delete;
+		CompilationContext& operator =(const CompilationContext&) = delete;
+
+		// Null if it hasn't been imported
+		shared_ptr<Binding::BoundCompilationUnit> GetImport(const std::string& path);
+		void AddImport(const std::string& path, shared_ptr<Binding::BoundCompilationUnit>);
+		// 0 if it hasn't got one yet, see SymbolCache
+		uint64_t GetKey(const std::string& path);
+		void SetKey(const std::string& path, uint64_t key);
+		// The one symbol for a struct declared in a file, a declaration that changed since replaces it.
+		// Whatever was bound against the old declaration keeps its symbol
+		shared_ptr<Symbol::StructTypeSymbol> InternStruct(Util::Atom file, Util::Atom name, unsigned size, Symbol::MemberList);
+		// The one symbol for pointers to a base symbol, pointerCount replaces the base's
+		shared_ptr<Symbol::TypeSymbol> GetPointerType(shared_ptr<Symbol::TypeSymbol> base, unsigned pointerCount);
+		bool IsLibrary(std::string_view name);
+		void AddLibrary(std::string_view name);
+		// Assembly of an imported file, linked after the main file in the order they're added
+		void AddUnit(std::string_view asmPath);
+		void AddPending(std::future<bool>);
+		// Waits for every import still being compiled, including any they import meanwhile. False if one failed
+		bool WaitPending();
+
+		// Only safe once nothing is being imported
+		std::vector<std::string>& GetLibraries();
+		std::vector<std::string>& GetUnits();
+	};
+}
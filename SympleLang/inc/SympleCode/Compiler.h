@@ -3,10 +3,12 @@
 #include <string_view>
 
 #include "SympleCode/DiagnosticBag.h"
-#include "SympleCode/Syntax/Token.h"
+#include "SympleCode/CompilationContext.h"
+#include "SympleCode/Syntax/Lexer.h"
 #include "SympleCode/Syntax/TranslationUnitSyntax.h"
 #include "SympleCode/Binding/Binder.h"
 #include "SympleCode/Binding/BoundCompilationUnit.h"
+#include "SympleCode/Binding/SymbolCache.h"
 #include "SympleCode/Emit/AsmEmitter.h"
 
 namespace Symple
@@ -14,30 +16,46 @@ namespace Symple
 	class __SYC_API Compiler
 	{
 	private:
-		std::string mPath, mAsmPath;
-		Syntax::TokenList mTokens;
+		std::string mPath, mAsmPath, mCachePath, mSymbolPath;
+		shared_ptr<CompilationContext> mContext;
+		shared_ptr<Syntax::Lexer> mLexer;
 		shared_ptr<Syntax::TranslationUnitSyntax> mAST;
 		shared_ptr<Binding::BoundCompilationUnit> mTree;
+		std::vector<Binding::SymbolCache::Import> mImports;
 		unique_ptr<Emit::AsmEmitter> mEmitter;
 
 		bool mAnyErrors = false;
-		static std::vector<std::string> sLibraries;
-		static std::vector<std::string> sUnits;
+
+		// What this file imports, from its cached symbols if there are any since that doesn't need it parsed
+		std::vector<Binding::SymbolCache::Import> ScanImports();
+		// Declarations of a file to import, null if it failed. Its own imports must be done already or they're
+		// compiled too, the rest of it is compiled in the background and waited on when linking
+		static shared_ptr<Binding::BoundCompilationUnit> CompileImport(shared_ptr<Compiler>);
 
 		friend class Binding::Binder;
 	public:
-		Compiler(char *path);
+		// Files compiled with the same context are one program, they share imports and are linked together
+		Compiler(char *path, shared_ptr<CompilationContext> context);
 
 		shared_ptr<DiagnosticBag> Lex();
 		shared_ptr<DiagnosticBag> Parse();
+		// Compiles every file imported from here ahead of binding, each on the thread pool as soon as the files it
+		// imports are done
+		void CompileImports();
 		shared_ptr<DiagnosticBag> Bind();
 		shared_ptr<Binding::BoundCompilationUnit> BindSymbols();
+		// Loads the bound symbols of an import built before, if nothing it was made from changed since.
+		// Emitting and compiling are skipped too, the object file from that build is linked instead
+		bool LoadSymbols();
+		bool StoreSymbols();
 		void Emit();
 		void Compile();
 		// Returns true if links successfully
 		bool Link(std::string_view output = "sy/bin/Main.exe", bool isLibrary = false);
 		int Exec(std::string_view args = "");
 
+		shared_ptr<CompilationContext> GetContext();
+
 		/// <summary>
 		/// Print Diagnostics
 		/// </summary>
@@ -45,5 +63,8 @@ namespace Symple
 		/// <param name="step">Step in witch diagnostics are for</param>
 		/// <returns>Returns true if there is an error</returns>
 		bool PrintDiagnosticBag(shared_ptr<DiagnosticBag> diagnostics, char *step = "Null Step");
+
+		// Where a file's build output with this extension goes, under the bin folder
+		static std::string GetOutputPath(std::string_view path, std::string_view extension);
 	};
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SympleCode/Syntax/Token.h"
+#include "SympleCode/Syntax/TokenBuffer.h"
 
 namespace Symple
 {
@@ -9,11 +9,13 @@ namespace Symple
 	public: enum Level : unsigned;
 	private:
 		Level mLevel;
-		shared_ptr<Syntax::Token> mToken;
+		Syntax::Token mToken;
+		// Keeps the token readable after the tree it's from is gone
+		shared_ptr<Syntax::TokenBuffer> mTokens;
 		std::string mMessage;
 	public:
-		Diagnostic(Level lvl, shared_ptr<Syntax::Token> tok, std::string_view msg)
-			: mLevel(lvl), mToken(tok), mMessage(msg) {}
+		Diagnostic(Level lvl, Syntax::Token tok, std::string_view msg)
+			: mLevel(lvl), mToken(tok), mTokens(tok.GetBuffer() ? tok.GetBuffer()->shared_from_this() : nullptr), mMessage(msg) {}
 
 		Level GetLevel()
 		{ return mLevel; }
@@ -18,22 +18,24 @@ namespace Symple
 	{
 	private:
 		std::vector<shared_ptr<Diagnostic>> mDiagnostics;
-		unsigned mMessageCount, mWarningCount, mErrorCount;
+		unsigned mMessageCount = 0, mWarningCount = 0, mErrorCount = 0;
 	public:
-		void ReportMessage(shared_ptr<Syntax::Token>, std::string_view msg);
-		void ReportWarning(shared_ptr<Syntax::Token>, std::string_view msg);
-		void ReportError(shared_ptr<Syntax::Token>, std::string_view msg);
+		void ReportMessage(Syntax::Token, std::string_view msg);
+		void ReportWarning(Syntax::Token, std::string_view msg);
+		void ReportError(Syntax::Token, std::string_view msg);
 
 		unsigned GetMessageCount();
 		unsigned GetWarningCount();
 		unsigned GetErrorCount();
 
 		std::vector<shared_ptr<Diagnostic>>& GetDiagnostics();
+		// Adds another bag's diagnostics after these ones
+		void Append(DiagnosticBag&);
 
 #if __SY_ALLOW_UNIMPLIMENTED
-		void ReportUnimplimentedMessage(shared_ptr<Syntax::Token>);
-		void ReportUnimplimentedWarning(shared_ptr<Syntax::Token>);
-		void ReportUnimplimentedError(shared_ptr<Syntax::Token>);
+		void ReportUnimplimentedMessage(Syntax::Token);
+		void ReportUnimplimentedWarning(Syntax::Token);
+		void ReportUnimplimentedError(Syntax::Token);
 #endif
 
 		void ReportBindError(shared_ptr<Syntax::Node>);
@@ -44,18 +46,18 @@ namespace Symple
 		void ReportTooManyArguments(shared_ptr<Syntax::CallExpressionSyntax>, unsigned paramIndex);
 		void ReportNoSuchFunction(shared_ptr<Syntax::CallExpressionSyntax>);
 
-		void ReportUndeclaredLabel(shared_ptr<Syntax::Token>);
-		void ReportUndeclaredIdentifier(shared_ptr<Syntax::Token>);
-		void ReportUnexpectedDllImportBody(shared_ptr<Syntax::Token>);
-		void ReportUnexpectedEndOfFile(shared_ptr<Syntax::Token>);
-		void ReportUnexpectedToken(shared_ptr<Syntax::Token>, Syntax::Token::Kind expectedKind);
-		void ReportUnknownToken(shared_ptr<Syntax::Token>);
+		void ReportUndeclaredLabel(Syntax::Token);
+		void ReportUndeclaredIdentifier(Syntax::Token);
+		void ReportUnexpectedDllImportBody(Syntax::Token);
+		void ReportUnexpectedEndOfFile(Syntax::Token);
+		void ReportUnexpectedToken(Syntax::Token, Syntax::Token::Kind expectedKind);
+		void ReportUnknownToken(Syntax::Token);
 
-		void ReportInvalidOperation(shared_ptr<Syntax::Token>, shared_ptr<Symbol::TypeSymbol> left, shared_ptr<Symbol::TypeSymbol> right);
-		void ReportInvalidOperation(shared_ptr<Syntax::Token>, shared_ptr<Symbol::TypeSymbol>);
+		void ReportInvalidOperation(Syntax::Token, shared_ptr<Symbol::TypeSymbol> left, shared_ptr<Symbol::TypeSymbol> right);
+		void ReportInvalidOperation(Syntax::Token, shared_ptr<Symbol::TypeSymbol>);
 
-		void ReportExpectedUnqualifiedID(shared_ptr<Syntax::Token>);
-		void ReportExpectedLValue(shared_ptr<Syntax::Token>);
+		void ReportExpectedUnqualifiedID(Syntax::Token);
+		void ReportExpectedLValue(Syntax::Token);
 		void ReportInvalidLiteral(shared_ptr<Syntax::LiteralExpressionSyntax>);
 	};
 }
\ No newline at end of file
@@ -17,7 +17,7 @@
 #include "SympleCode/Binding/BoundFunctionPointer.h"
 
 #include "SympleCode/Symbol/FunctionSymbol.h"
-#include "SympleCode/Emit/Scope.h"
+#include "SympleCode/Symbol/SymbolTable.h"
 
 namespace Symple::Emit
 {
@@ -32,7 +32,7 @@ namespace Symple::Emit
 
 		shared_ptr<Symbol::FunctionSymbol> mFunction;
 		shared_ptr<Binding::BoundCompilationUnit> mCompilationUnit;
-		shared_ptr<Scope> mScope;
+		Symbol::SymbolTable mScope;
 		std::vector<std::string> mStringLiterals;
 
 		void BeginScope();
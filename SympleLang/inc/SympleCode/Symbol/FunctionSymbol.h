@@ -4,6 +4,8 @@
 #include "SympleCode/Symbol/TypeSymbol.h"
 #include "SympleCode/Symbol/ParameterSymbol.h"
 
+#include "SympleCode/Util/Atom.h"
+
 namespace Symple::Symbol
 {
 	class FunctionSymbol : public Symbol
@@ -11,12 +13,12 @@ namespace Symple::Symbol
 	public: enum CallingConvention : unsigned;
 	private:
 		shared_ptr<TypeSymbol> mType;
-		std::string mName;
+		Util::Atom mName;
 		ParameterList mParameters;
 		CallingConvention mCallingConvention;
 		bool mDllImport : 1, mDllExport : 1, mGlobal : 1;
 	public:
-		FunctionSymbol(shared_ptr<TypeSymbol> ty, std::string_view name, ParameterList& params, CallingConvention conv, bool dllin, bool dllout, bool isGlobal)
+		FunctionSymbol(shared_ptr<TypeSymbol> ty, Util::Atom name, ParameterList& params, CallingConvention conv, bool dllin, bool dllout, bool isGlobal)
 			: mType(ty), mName(name), mParameters(params), mCallingConvention(conv), mDllImport(dllin), mDllExport(dllout), mGlobal(isGlobal)
 		{}
 
@@ -65,6 +67,9 @@ namespace Symple::Symbol
 		{ return mType; }
 
 		std::string_view GetName()
+		{ return mName.GetText(); }
+
+		Util::Atom GetAtom()
 		{ return mName; }
 
 		ParameterList GetParameters()
@@ -88,4 +93,6 @@ namespace Symple::Symbol
 			StdCall,
 		};
 	};
+
+	typedef std::vector<shared_ptr<FunctionSymbol>> FunctionList;
 }
\ No newline at end of file
@@ -2,14 +2,16 @@
 
 #include "SympleCode/Symbol/Symbol.h"
 
+#include "SympleCode/Util/Atom.h"
+
 namespace Symple::Symbol
 {
 	class LabelSymbol : public Symbol
 	{
 	private:
-		std::string mLabel;
+		Util::Atom mLabel;
 	public:
-		LabelSymbol(std::string_view label)
+		LabelSymbol(Util::Atom label)
 			: mLabel(label)
 		{}
 
@@ -27,6 +29,9 @@ namespace Symple::Symbol
 		{ os << GetLabel(); }
 
 		std::string_view GetLabel()
+		{ return mLabel.GetText(); }
+
+		Util::Atom GetAtom()
 		{ return mLabel; }
 	};
 
@@ -11,7 +11,7 @@ namespace Symple::Symbol
 	private:
 		shared_ptr<Binding::BoundConstant> mInitializer;
 	public:
-		MemberSymbol(shared_ptr<TypeSymbol> ty, std::string_view name, shared_ptr<Binding::BoundConstant> init)
+		MemberSymbol(shared_ptr<TypeSymbol> ty, Util::Atom name, shared_ptr<Binding::BoundConstant> init)
 			: VariableSymbol(ty, name), mInitializer(init)
 		{}
 
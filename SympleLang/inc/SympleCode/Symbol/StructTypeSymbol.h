@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include "SympleCode/Symbol/TypeSymbol.h"
 #include "SympleCode/Symbol/MemberSymbol.h"
 
@@ -9,9 +11,18 @@ namespace Symple::Symbol
 	{
 	private:
 		MemberList mMembers;
+		std::unordered_map<Util::Atom, shared_ptr<MemberSymbol>> mIndex;
 	public:
-		StructTypeSymbol(std::string_view name, unsigned sz, MemberList members)
-			: TypeSymbol(Struct, name, sz), mMembers(members) {}
+		StructTypeSymbol(Util::Atom name, unsigned sz, MemberList members)
+			: TypeSymbol(Struct, name, sz), mMembers(members)
+		{
+			// The first declaration wins, like a front to back search would
+			for (auto member : mMembers)
+				mIndex.insert({ member->GetAtom(), member });
+		}
+
+		// Whether a declaration of it with this size and these members still makes the same symbol, see CompilationContext::InternStruct
+		bool Matches(unsigned size, MemberList& members);
 
 		virtual Kind GetKind() override
 		{ return StructType; }
@@ -43,5 +54,12 @@ namespace Symple::Symbol
 
 		MemberList GetMembers()
 		{ return mMembers; }
+
+		// Null if there's no member by that name
+		shared_ptr<MemberSymbol> FindMember(Util::Atom name)
+		{
+			auto member = mIndex.find(name);
+			return member == mIndex.end() ? nullptr : member->second;
+		}
 	};
 }
\ No newline at end of file
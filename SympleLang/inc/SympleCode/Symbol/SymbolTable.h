@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "SympleCode/Symbol/VariableSymbol.h"
+
+#include "SympleCode/Util/Atom.h"
+
+namespace Symple::Symbol
+{
+	// Variables visible from the current scope, keyed by name. A declaration hides any outer one with the same name,
+	// and ending its scope puts the outer one back
+	class SymbolTable
+	{
+	private:
+		struct Entry
+		{
+			shared_ptr<VariableSymbol> Symbol;
+			unsigned Depth = -1;
+		};
+
+		std::unordered_map<Util::Atom, Entry> mSymbols;
+		// What each declaration replaced, undone in reverse when its scope ends
+		std::vector<std::pair<Util::Atom, Entry>> mUndo;
+		// Size of the undo log when each open scope began
+		std::vector<unsigned> mScopes;
+		// Read through for names this one doesn't have, never written to
+		const SymbolTable* mParent = nullptr;
+		unsigned mParentDepth = 0;
+
+		const Entry* Find(Util::Atom name) const
+		{
+			auto entry = mSymbols.find(name);
+			if (entry != mSymbols.end())
+				return &entry->second;
+			return mParent ? mParent->Find(name) : nullptr;
+		}
+	public:
+		SymbolTable() = default;
+		// Sees everything visible in the parent, which must outlive it and not change meanwhile.
+		// Declarations only go into this one, so tables over the same parent can be used from separate threads
+		SymbolTable(const SymbolTable* parent)
+			: mParent(parent), mParentDepth(parent->GetDepth()) {}
+
+		void BeginScope()
+		{ mScopes.push_back(mUndo.size()); }
+
+		void EndScope()
+		{
+			for (unsigned i = mUndo.size(); i > mScopes.back(); i--)
+			{
+				auto& [name, previous] = mUndo[i - 1];
+				if (previous.Symbol)
+					mSymbols[name] = previous;
+				else
+					mSymbols.erase(name);
+			}
+			mUndo.resize(mScopes.back());
+			mScopes.pop_back();
+		}
+
+		void Clear()
+		{
+			mSymbols.clear();
+			mUndo.clear();
+			mScopes.clear();
+		}
+
+		void DeclareVariable(shared_ptr<VariableSymbol> var)
+		{
+			Entry& entry = mSymbols[var->GetAtom()];
+			mUndo.push_back({ var->GetAtom(), entry });
+			entry = { var, GetDepth() };
+		}
+
+		// Number of open scopes, counting the parent's
+		unsigned GetDepth() const
+		{ return mParentDepth + mScopes.size(); }
+
+		shared_ptr<VariableSymbol> GetVariableSymbol(Util::Atom name)
+		{
+			const Entry* entry = Find(name);
+			return entry ? entry->Symbol : nullptr;
+		}
+
+		// Depth of the scope the visible variable was declared in, -1 if there isn't one
+		unsigned GetVariableDepth(Util::Atom name)
+		{
+			const Entry* entry = Find(name);
+			return entry ? entry->Depth : -1;
+		}
+	};
+}
@@ -7,6 +7,8 @@
 #include "SympleCode/Memory.h"
 #include "SympleCode/Symbol/Symbol.h"
 
+#include "SympleCode/Util/Atom.h"
+
 namespace Symple::Symbol
 {
 	class TypeSymbol : public Symbol
@@ -14,16 +16,22 @@ namespace Symple::Symbol
 	public: enum TypeKind : unsigned;
 	private:
 		TypeKind mTypeKind;
-		std::string mName;
+		Util::Atom mName;
 		unsigned mSize;
 		bool mFloat;
 		
 
 		unsigned mPointerCount;
 		std::vector<char> mModifiers;
+		shared_ptr<TypeSymbol> mBase;
 	public:
-		TypeSymbol(TypeKind, std::string_view name, unsigned size, bool isFloat = false, unsigned pointerCount = 0, std::vector<char> mods = {});
+		// Use the builtin types below, CompilationContext::GetPointerType or CompilationContext::InternStruct instead
+		TypeSymbol(TypeKind, Util::Atom name, unsigned size, bool isFloat = false, unsigned pointerCount = 0, std::vector<char> mods = {});
+
+		// A new symbol for pointers to a base symbol, pointerCount replaces the base's. The context interns them
+		static shared_ptr<TypeSymbol> MakePointerType(shared_ptr<TypeSymbol> base, unsigned pointerCount);
 
+		// Types of one context are equal exactly when they're the same symbol
 		bool Equals(shared_ptr<TypeSymbol>);
 
 		bool Is(TypeKind);
@@ -37,11 +45,14 @@ namespace Symple::Symbol
 		virtual Kind GetKind() override;
 		TypeKind GetTypeKind();
 		std::string_view GetName();
+		Util::Atom GetAtom();
 		unsigned GetSize();
 		bool IsFloat();
 
 		unsigned GetPointerCount();
 		std::vector<char>& GetModifiers();
+		// What a pointer type points to, null for anything else
+		shared_ptr<TypeSymbol> GetBase();
 
 		static shared_ptr<TypeSymbol> ErrorType;
 
@@ -62,6 +73,9 @@ namespace Symple::Symbol
 		static shared_ptr<TypeSymbol> VoidPointerType;
 		static shared_ptr<TypeSymbol> BytePointerType;
 		static shared_ptr<TypeSymbol> CharPointerType;
+
+		// One of the types above for a builtin kind without pointers, ErrorType for anything else
+		static shared_ptr<TypeSymbol> GetBuiltinType(TypeKind);
 	public:
 		enum TypeKind : unsigned
 		{
@@ -3,15 +3,17 @@
 #include "SympleCode/Symbol/Symbol.h"
 #include "SympleCode/Symbol/TypeSymbol.h"
 
+#include "SympleCode/Util/Atom.h"
+
 namespace Symple::Symbol
 {
 	class VariableSymbol : public Symbol
 	{
 	private:
 		shared_ptr<TypeSymbol> mType;
-		std::string mName;
+		Util::Atom mName;
 	public:
-		VariableSymbol(shared_ptr<TypeSymbol> ty, std::string_view name)
+		VariableSymbol(shared_ptr<TypeSymbol> ty, Util::Atom name)
 			: mType(ty), mName(name)
 		{}
 
@@ -32,6 +34,9 @@ namespace Symple::Symbol
 		{ return mType; }
 
 		std::string_view GetName()
+		{ return mName.GetText(); }
+
+		Util::Atom GetAtom()
 		{ return mName; }
 	};
 
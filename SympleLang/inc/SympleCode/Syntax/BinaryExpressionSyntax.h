@@ -7,10 +7,11 @@ namespace Symple::Syntax
 	class BinaryExpressionSyntax : public ExpressionSyntax
 	{
 	private:
-		shared_ptr<ExpressionSyntax> mLeft, mRight;
+		ExpressionSyntax* mLeft;
+		ExpressionSyntax* mRight;
 	public:
-		BinaryExpressionSyntax(shared_ptr<Token> op, shared_ptr<ExpressionSyntax> left, shared_ptr<ExpressionSyntax> right)
-			: ExpressionSyntax(op), mLeft(left), mRight(right) {}
+		BinaryExpressionSyntax(Token op, shared_ptr<ExpressionSyntax> left, shared_ptr<ExpressionSyntax> right)
+			: ExpressionSyntax(op), mLeft(left.get()), mRight(right.get()) {}
 
 		virtual Kind GetKind() override
 		{ return BinaryExpression; }
@@ -20,7 +21,7 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os); 
 			os << " [";
-			GetOperator()->PrintShort(os);
+			GetOperator().PrintShort(os);
 			os.put(']');
 
 			std::string newIndent(indent);
@@ -30,13 +31,13 @@ namespace Symple::Syntax
 			os.put('\n'); GetRight()->Print(os, newIndent, true, "Right = ");
 		}
 
-		shared_ptr<Token> GetOperator()
+		Token GetOperator()
 		{ return GetToken(); }
 
 		shared_ptr<ExpressionSyntax> GetLeft()
-		{ return mLeft; }
+		{ return Share(mLeft); }
 
 		shared_ptr<ExpressionSyntax> GetRight()
-		{ return mRight; }
+		{ return Share(mRight); }
 	};
 }
\ No newline at end of file
@@ -9,10 +9,10 @@ namespace Symple::Syntax
 	class BlockStatementSyntax : public StatementSyntax
 	{
 	private:
-		std::vector<shared_ptr<StatementSyntax>> mStatements;
-		shared_ptr<Token> mClose;
+		Util::ArenaArray<StatementSyntax*> mStatements;
+		Token mClose;
 	public:
-		BlockStatementSyntax(shared_ptr<Token> open, std::vector<shared_ptr<StatementSyntax>> statements, shared_ptr<Token> close)
+		BlockStatementSyntax(Token open, Util::ArenaArray<StatementSyntax*> statements, Token close)
 			: StatementSyntax(open), mStatements(statements), mClose(close) {}
 
 		virtual Kind GetKind() override
@@ -30,13 +30,13 @@ namespace Symple::Syntax
 			{ os.put('\n'); statement->Print(os, newIndent, statement == GetStatements().back()); }
 		}
 
-		shared_ptr<Token> GetOpen()
+		Token GetOpen()
 		{ return GetToken(); }
 
 		std::vector<shared_ptr<StatementSyntax>> GetStatements()
-		{ return mStatements; }
+		{ return Share(mStatements); }
 
-		shared_ptr<Token> GetClose()
+		Token GetClose()
 		{ return mClose; }
 	};
 }
\ No newline at end of file
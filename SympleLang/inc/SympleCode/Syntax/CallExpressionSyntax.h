@@ -7,11 +7,11 @@ namespace Symple::Syntax
 	class CallExpressionSyntax : public ExpressionSyntax
 	{
 	private:
-		shared_ptr<Token> mOpenParenthesis;
-		ExpressionList mArguments;
-		shared_ptr<Token> mCloseParenthesis;
+		Token mOpenParenthesis;
+		Util::ArenaArray<ExpressionSyntax*> mArguments;
+		Token mCloseParenthesis;
 	public:
-		CallExpressionSyntax(shared_ptr<Token> name, shared_ptr<Token> openParen, ExpressionList args, shared_ptr<Token> closeParen)
+		CallExpressionSyntax(Token name, Token openParen, Util::ArenaArray<ExpressionSyntax*> args, Token closeParen)
 			: ExpressionSyntax(name), mOpenParenthesis(openParen), mArguments(args), mCloseParenthesis(closeParen) {}
 
 		virtual Kind GetKind() override
@@ -22,7 +22,7 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 
-			os << " '" << GetName()->GetText() << " (" << GetArguments().size() << ")'";
+			os << " '" << GetName().GetText() << " (" << GetArguments().size() << ")'";
 
 			std::string newIndent(indent);
 			newIndent += GetAddIndent(last);
@@ -31,16 +31,16 @@ namespace Symple::Syntax
 			{ os.put('\n'); arg->Print(os, newIndent, arg == GetArguments().back()); }
 		}
 
-		shared_ptr<Token> GetName()
+		Token GetName()
 		{ return GetToken(); }
 
-		shared_ptr<Token> GetOpenParenthesis()
+		Token GetOpenParenthesis()
 		{ return mOpenParenthesis; }
 
 		ExpressionList GetArguments()
-		{ return mArguments; }
+		{ return Share(mArguments); }
 
-		shared_ptr<Token> GetCloseParenthesis()
+		Token GetCloseParenthesis()
 		{ return mCloseParenthesis; }
 	};
 }
\ No newline at end of file
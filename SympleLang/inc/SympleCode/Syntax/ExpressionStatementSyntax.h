@@ -8,10 +8,10 @@ namespace Symple::Syntax
 	class ExpressionStatementSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<ExpressionSyntax> mExpression;
+		ExpressionSyntax* mExpression;
 	public:
 		ExpressionStatementSyntax(shared_ptr<ExpressionSyntax> expr)
-			: StatementSyntax(expr->GetToken()), mExpression(expr) {}
+			: StatementSyntax(expr->GetToken()), mExpression(expr.get()) {}
 
 		virtual Kind GetKind() override
 		{ return ExpressionStatement; }
@@ -28,6 +28,6 @@ namespace Symple::Syntax
 		}
 
 		shared_ptr<ExpressionSyntax> GetExpression()
-		{ return mExpression; }
+		{ return Share(mExpression); }
 	};
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Symple::Syntax
 	class ExpressionSyntax : public Node
 	{
 	public:
-		ExpressionSyntax(shared_ptr<Token> tok)
+		ExpressionSyntax(Token tok)
 			: Node(tok) {}
 
 		virtual Kind GetKind() override
@@ -12,17 +12,17 @@ namespace Symple::Syntax
 	class ExternFunctionSyntax : public MemberSyntax
 	{
 	private:
-		shared_ptr<Token> mKeyword;
-		shared_ptr<TypeSyntax> mType;
-		shared_ptr<Token> mOpenParenthesis;
-		VariableDeclarationList mParameters;
-		shared_ptr<Token> mCloseParenthesis;
-		TokenList mModifiers;
+		Token mKeyword;
+		TypeSyntax* mType;
+		Token mOpenParenthesis;
+		Util::ArenaArray<VariableDeclarationSyntax*> mParameters;
+		Token mCloseParenthesis;
+		Util::ArenaArray<Token> mModifiers;
 	public:
-		ExternFunctionSyntax(shared_ptr<Token> keyword, shared_ptr<TypeSyntax> type, shared_ptr<Token> name,
-			shared_ptr<Token> openParen, VariableDeclarationList& params, shared_ptr<Token> closeParen,
-			TokenList mods)
-			: MemberSyntax(name), mKeyword(keyword), mType(type), mOpenParenthesis(openParen), mParameters(params), mCloseParenthesis(closeParen), mModifiers(mods) {}
+		ExternFunctionSyntax(Token keyword, shared_ptr<TypeSyntax> type, Token name,
+			Token openParen, Util::ArenaArray<VariableDeclarationSyntax*> params, Token closeParen,
+			Util::ArenaArray<Token> mods)
+			: MemberSyntax(name), mKeyword(keyword), mType(type.get()), mOpenParenthesis(openParen), mParameters(params), mCloseParenthesis(closeParen), mModifiers(mods) {}
 
 		virtual Kind GetKind() override
 		{ return ExternFunction; }
@@ -32,7 +32,7 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 
-			os << " '"; GetType()->PrintShort(os); os << ' ' << GetName()->GetText(); os.put('(');
+			os << " '"; GetType()->PrintShort(os); os << ' ' << GetName().GetText(); os.put('(');
 			for (auto param : GetParameters())
 			{
 				param->GetType()->PrintShort(os);
@@ -44,7 +44,7 @@ namespace Symple::Syntax
 				os.put(' ');
 			for (auto mod : GetModifiers())
 			{
-				mod->PrintShort(os);
+				mod.PrintShort(os);
 				if (mod != GetModifiers().back())
 					os << ", ";
 			}
@@ -57,25 +57,25 @@ namespace Symple::Syntax
 			{ os.put('\n'); param->Print(os, newIndent, param == GetParameters().back(), "[Param] "); }
 		}
 
-		shared_ptr<Token> GetKeyword()
+		Token GetKeyword()
 		{ return mKeyword; }
 
 		shared_ptr<TypeSyntax> GetType()
-		{ return mType; }
+		{ return Share(mType); }
 
-		shared_ptr<Token> GetName()
+		Token GetName()
 		{ return GetToken(); }
 
-		shared_ptr<Token> GetOpenParenthesis()
+		Token GetOpenParenthesis()
 		{ return mOpenParenthesis; }
 
 		VariableDeclarationList GetParameters()
-		{ return mParameters; }
+		{ return Share(mParameters); }
 
-		shared_ptr<Token> GetCloseParenthesis()
+		Token GetCloseParenthesis()
 		{ return mCloseParenthesis; }
 
-		TokenList& GetModifiers()
-		{ return mModifiers; }
+		TokenList GetModifiers()
+		{ return TokenList(mModifiers.begin(), mModifiers.end()); }
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include "SympleCode/Syntax/Token.h"
 
 namespace Symple::Syntax
@@ -8,5 +10,8 @@ namespace Symple::Syntax
 	{
 		static unsigned GetUnaryOperatorPrecedence(Token::Kind);
 		static unsigned GetBinaryOperatorPrecedence(Token::Kind);
+
+		// Returns Token::Identifier if the text isn't a keyword
+		static Token::Kind GetKeywordKind(std::string_view);
 	};
 }
\ No newline at end of file
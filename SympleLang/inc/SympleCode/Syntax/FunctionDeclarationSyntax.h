@@ -12,17 +12,17 @@ namespace Symple::Syntax
 	class FunctionDeclarationSyntax : public MemberSyntax
 	{
 	private:
-		shared_ptr<TypeSyntax> mType;
-		shared_ptr<Token> mOpenParenthesis;
-		VariableDeclarationList mParameters;
-		shared_ptr<Token> mCloseParenthesis;
-		TokenList mModifiers;
-		shared_ptr<StatementSyntax> mBody;
+		TypeSyntax* mType;
+		Token mOpenParenthesis;
+		Util::ArenaArray<VariableDeclarationSyntax*> mParameters;
+		Token mCloseParenthesis;
+		Util::ArenaArray<Token> mModifiers;
+		StatementSyntax* mBody;
 	public:
-		FunctionDeclarationSyntax(shared_ptr<TypeSyntax> type, shared_ptr<Token> name,
-			shared_ptr<Token> openParen, VariableDeclarationList& params, shared_ptr<Token> closeParen,
-			TokenList& modifiers, shared_ptr<StatementSyntax> body)
-			: MemberSyntax(name), mType(type), mOpenParenthesis(openParen), mParameters(params), mCloseParenthesis(closeParen), mModifiers(modifiers), mBody(body) {}
+		FunctionDeclarationSyntax(shared_ptr<TypeSyntax> type, Token name,
+			Token openParen, Util::ArenaArray<VariableDeclarationSyntax*> params, Token closeParen,
+			Util::ArenaArray<Token> modifiers, shared_ptr<StatementSyntax> body)
+			: MemberSyntax(name), mType(type.get()), mOpenParenthesis(openParen), mParameters(params), mCloseParenthesis(closeParen), mModifiers(modifiers), mBody(body.get()) {}
 
 		virtual Kind GetKind() override
 		{ return FunctionDeclaration; }
@@ -32,7 +32,7 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 
-			os << " '"; GetType()->PrintShort(os); os << ' ' << GetName()->GetText() << '(';
+			os << " '"; GetType()->PrintShort(os); os << ' ' << GetName().GetText() << '(';
 			for (auto param : GetParameters())
 			{
 				param->GetType()->PrintShort(os);
@@ -44,7 +44,7 @@ namespace Symple::Syntax
 				os.put(' ');
 			for (auto mod : GetModifiers())
 			{
-				mod->PrintShort(os);
+				mod.PrintShort(os);
 				if (mod != GetModifiers().back())
 					os << ", ";
 			}
@@ -59,24 +59,24 @@ namespace Symple::Syntax
 		}
 
 		shared_ptr<TypeSyntax> GetType()
-		{ return mType; }
+		{ return Share(mType); }
 
-		shared_ptr<Token> GetName()
+		Token GetName()
 		{ return GetToken(); }
 
-		shared_ptr<Token> GetOpenParenthesis()
+		Token GetOpenParenthesis()
 		{ return mOpenParenthesis; }
 
 		VariableDeclarationList GetParameters()
-		{ return mParameters; }
+		{ return Share(mParameters); }
 
-		shared_ptr<Token> GetCloseParenthesis()
+		Token GetCloseParenthesis()
 		{ return mCloseParenthesis; }
 
-		TokenList& GetModifiers()
-		{ return mModifiers; }
+		TokenList GetModifiers()
+		{ return TokenList(mModifiers.begin(), mModifiers.end()); }
 
 		shared_ptr<StatementSyntax> GetBody()
-		{ return mBody; }
+		{ return Share(mBody); }
 	};
 }
\ No newline at end of file
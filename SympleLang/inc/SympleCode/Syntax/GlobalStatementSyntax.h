@@ -8,10 +8,10 @@ namespace Symple::Syntax
 	class GlobalStatementSyntax : public MemberSyntax
 	{
 	private:
-		shared_ptr<StatementSyntax> mStatement;
+		StatementSyntax* mStatement;
 	public:
 		GlobalStatementSyntax(shared_ptr<StatementSyntax> stmt)
-			: MemberSyntax(stmt->GetToken()), mStatement(stmt) {}
+			: MemberSyntax(stmt->GetToken()), mStatement(stmt.get()) {}
 
 		virtual Kind GetKind() override
 		{ return GlobalStatement; }
@@ -28,6 +28,6 @@ namespace Symple::Syntax
 		}
 
 		shared_ptr<StatementSyntax> GetStatement()
-		{ return mStatement; }
+		{ return Share(mStatement); }
 	};
 }
\ No newline at end of file
@@ -7,9 +7,9 @@ namespace Symple::Syntax
 	class GotoStatementSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<Token> mKeyword;
+		Token mKeyword;
 	public:
-		GotoStatementSyntax(shared_ptr<Token> key, shared_ptr<Token> label)
+		GotoStatementSyntax(Token key, Token label)
 			: StatementSyntax(label), mKeyword(key) {}
 
 		virtual Kind GetKind() override
@@ -23,13 +23,13 @@ namespace Symple::Syntax
 			std::string newIndent(indent);
 			newIndent += GetAddIndent(last);
 
-			os.put('\n'); GetLabel()->Print(os, newIndent, true, "Label = ");
+			os.put('\n'); GetLabel().Print(os, newIndent, true, "Label = ");
 		}
 
-		shared_ptr<Token> GetKeyword()
+		Token GetKeyword()
 		{ return mKeyword; }
 
-		shared_ptr<Token> GetLabel()
+		Token GetLabel()
 		{ return GetToken(); }
 	};
 }
\ No newline at end of file
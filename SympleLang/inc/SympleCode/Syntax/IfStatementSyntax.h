@@ -8,13 +8,13 @@ namespace Symple::Syntax
 	class IfStatementSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<ParenthesizedExpressionSyntax> mCondition;
-		shared_ptr<StatementSyntax> mThen;
-		shared_ptr<Token> mElseKeyword;
-		shared_ptr<StatementSyntax> mElse;
+		ParenthesizedExpressionSyntax* mCondition;
+		StatementSyntax* mThen;
+		Token mElseKeyword;
+		StatementSyntax* mElse;
 	public:
-		IfStatementSyntax(shared_ptr<Token> ifKey, shared_ptr<ParenthesizedExpressionSyntax> cond, shared_ptr<StatementSyntax> then, shared_ptr<Token> elseKey, shared_ptr<StatementSyntax> elze)
-			: StatementSyntax(ifKey), mCondition(cond), mThen(then), mElseKeyword(elseKey), mElse(elze) {}
+		IfStatementSyntax(Token ifKey, shared_ptr<ParenthesizedExpressionSyntax> cond, shared_ptr<StatementSyntax> then, Token elseKey, shared_ptr<StatementSyntax> elze)
+			: StatementSyntax(ifKey), mCondition(cond.get()), mThen(then.get()), mElseKeyword(elseKey), mElse(elze.get()) {}
 
 		virtual Kind GetKind() override
 		{ return IfStatement; }
@@ -33,19 +33,19 @@ namespace Symple::Syntax
 			{ os.put('\n'); GetElse()->Print(os, newIndent, true, "Else = "); }
 		}
 
-		shared_ptr<Token> GetIfKeyword()
+		Token GetIfKeyword()
 		{ return GetToken(); }
 
 		shared_ptr<ParenthesizedExpressionSyntax> GetCondition()
-		{ return mCondition; }
+		{ return Share(mCondition); }
 
 		shared_ptr<StatementSyntax> GetThen()
-		{ return mThen; }
+		{ return Share(mThen); }
 
-		shared_ptr<Token> GetElseKeyword()
+		Token GetElseKeyword()
 		{ return mElseKeyword; }
 
 		shared_ptr<StatementSyntax> GetElse()
-		{ return mElse; }
+		{ return Share(mElse); }
 	};
 }
\ No newline at end of file
@@ -7,9 +7,9 @@ namespace Symple::Syntax
 	class ImportStatementSyntax : public MemberSyntax
 	{
 	private:
-		shared_ptr<Token> mKeyword;
+		Token mKeyword;
 	public:
-		ImportStatementSyntax(shared_ptr<Token> key, shared_ptr<Token> import)
+		ImportStatementSyntax(Token key, Token import)
 			: MemberSyntax(import), mKeyword(key) {}
 
 		virtual Kind GetKind() override
@@ -23,13 +23,13 @@ namespace Symple::Syntax
 			std::string newIndent(indent);
 			newIndent += GetAddIndent(last);
 
-			os.put('\n'); GetImport()->Print(os, newIndent, true, "Import = ");
+			os.put('\n'); GetImport().Print(os, newIndent, true, "Import = ");
 		}
 
-		shared_ptr<Token> GetKeyword()
+		Token GetKeyword()
 		{ return mKeyword; }
 
-		shared_ptr<Token> GetImport()
+		Token GetImport()
 		{ return GetToken(); }
 	};
 }
\ No newline at end of file
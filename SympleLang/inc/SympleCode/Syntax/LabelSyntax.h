@@ -7,18 +7,18 @@ namespace Symple::Syntax
 	class LabelSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<Token> mColon;
+		Token mColon;
 	public:
-		LabelSyntax(shared_ptr<Token> label, shared_ptr<Token> colon)
+		LabelSyntax(Token label, Token colon)
 			: StatementSyntax(label), mColon(colon) {}
 
 		virtual Kind GetKind() override
 		{ return Label; }
 
-		shared_ptr<Token> GetLabel()
+		Token GetLabel()
 		{ return GetToken(); }
 
-		shared_ptr<Token> GetColon()
+		Token GetColon()
 		{ return mColon; }
 	};
 }
\ No newline at end of file
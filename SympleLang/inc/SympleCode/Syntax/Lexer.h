@@ -3,31 +3,53 @@
 #include <string>
 
 #include "SympleCode/Syntax/Token.h"
+#include "SympleCode/Syntax/TokenBuffer.h"
 
 #include "SympleCode/DiagnosticBag.h"
+#include "SympleCode/Util/FileUtil.h"
 
 namespace Symple::Syntax
 {
 	class __SYC_API Lexer
 	{
 	private:
-		std::string mSource;
+		char* mFile;
+		shared_ptr<Util::MappedFile> mSourceFile;
+		char* mSource;
+		unsigned mLength;
 		unsigned mPosition = 0;
-		shared_ptr<Trivia> mTrivia;
+		Trivia::Kind mTriviaKind = Trivia::Unknown;
+		unsigned mTriviaPosition = 0, mTriviaLength = 0;
+		shared_ptr<TokenBuffer> mTokens;
+		// Direct mapped cache in front of the shared atom table, the keys point into the source
+		static constexpr unsigned sAtomCacheSize = 1024;
+		std::pair<std::string_view, Util::Atom> mAtomCache[sAtomCacheSize];
 
-		char* mFile;
-		unsigned mLine = 1, mColumn = 0;
 		shared_ptr<DiagnosticBag> mDiagnosticBag = make_shared<DiagnosticBag>();
+
+		static constexpr unsigned sParallelChunkSize = 1 << 20;
+
+		// Lexes [begin, end) of the parent's source into a separate buffer
+		Lexer(Lexer& parent, unsigned begin, unsigned end);
 	public:
 		Lexer(char* mFile);
 		Lexer(char* mFile, std::string& mSource);
+		Lexer(char* mFile, shared_ptr<Util::MappedFile> mSourceFile);
+		// Only lexes [begin, end) of the source, with LexSpan
+		Lexer(char* mFile, shared_ptr<Util::MappedFile> mSourceFile, unsigned begin, unsigned end);
 
-		shared_ptr<Token> Lex();
+		Token Lex();
+		// Lexes the whole file in chunks on the thread pool.
+		// Returns false without lexing anything if the file is too small to split or lexing already started
+		bool LexParallel();
+		// Lexes up to end and closes the tokens with an EndOfFile there, for reparsing part of a file.
+		// Returns false if end doesn't fall right after a token
+		bool LexSpan(unsigned end);
 
-		shared_ptr<Token> LexAtom(Token::Kind);
-		shared_ptr<Token> LexIdentifier();
-		shared_ptr<Token> LexString();
-		shared_ptr<Token> LexNumber();
+		Token LexAtom(Token::Kind);
+		Token LexIdentifier();
+		Token LexString();
+		Token LexNumber();
 
 		static bool IsWhiteSpace(char);
 		static bool IsIdentifier(char);
@@ -36,13 +58,23 @@ namespace Symple::Syntax
 		bool IsNumber();
 
 		std::string_view GetSource();
+		// Tokens reference this directly, so it must outlive them
+		shared_ptr<Util::MappedFile> GetSourceFile();
+		// Every token lexed so far, Lex() appends to it
+		shared_ptr<TokenBuffer> GetTokens();
 		char* GetFile();
 
 		shared_ptr<DiagnosticBag> GetDiagnosticBag();
 	private:
-		bool CheckNewLine();
+		// Lexes tokens starting before end, or up to EndOfFile if end is the source length.
+		// The trivia before the first one must already be scanned
+		void LexUntil(unsigned end);
+		void LexTrivia();
+		Token LexToken();
+		Token Push(Token::Kind, char* beg, char* end, Util::Atom = {});
+		Util::Atom Intern(std::string_view);
 
-		char& Peek(unsigned off = 0);
-		char& Next();
+		char Peek(unsigned off = 0);
+		char* Next();
 	};
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Symple::Syntax
 	class LiteralExpressionSyntax : public ExpressionSyntax
 	{
 	public:
-		LiteralExpressionSyntax(shared_ptr<Token> tok)
+		LiteralExpressionSyntax(Token tok)
 			: ExpressionSyntax(tok) {}
 
 		virtual Kind GetKind() override
@@ -15,13 +15,13 @@ namespace Symple::Syntax
 
 		virtual void Print(std::ostream& os = std::cout, std::string_view indent = "", bool last = true, std::string_view label = "") override
 		{
-			GetLiteral()->Print(os, indent, last, label);
+			GetLiteral().Print(os, indent, last, label);
 			os << " (";
 			PrintName(os);
 			os.put(')');
 		}
 
-		shared_ptr<Token> GetLiteral()
+		Token GetLiteral()
 		{ return GetToken(); }
 	};
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Symple::Syntax
 	class MemberSyntax : public Node
 	{
 	public:
-		MemberSyntax(shared_ptr<Token> tok)
+		MemberSyntax(Token tok)
 			: Node(tok) {}
 
 		virtual Kind GetKind() override
@@ -7,7 +7,7 @@ namespace Symple::Syntax
 	class NameExpressionSyntax : public ExpressionSyntax
 	{
 	public:
-		NameExpressionSyntax(shared_ptr<Token> tok)
+		NameExpressionSyntax(Token tok)
 			: ExpressionSyntax(tok) {}
 
 		virtual Kind GetKind() override
@@ -7,9 +7,9 @@ namespace Symple::Syntax
 	class NativeStatementSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<Token> mAssembly;
+		Token mAssembly;
 	public:
-		NativeStatementSyntax(shared_ptr<Token> key, shared_ptr<Token> code)
+		NativeStatementSyntax(Token key, Token code)
 			: StatementSyntax(key), mAssembly(code) {}
 
 		virtual Kind GetKind() override
@@ -23,13 +23,13 @@ namespace Symple::Syntax
 			std::string newIndent(indent);
 			newIndent += GetAddIndent(last);
 
-			os.put('\n'); GetAssembly()->Print(os, newIndent, true, "Assembly = ");
+			os.put('\n'); GetAssembly().Print(os, newIndent, true, "Assembly = ");
 		}
 
-		shared_ptr<Token> GetKeyword()
+		Token GetKeyword()
 		{ return GetToken(); }
 
-		shared_ptr<Token> GetAssembly()
+		Token GetAssembly()
 		{ return mAssembly; }
 	};
 }
\ No newline at end of file
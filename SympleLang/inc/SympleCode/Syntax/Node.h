@@ -1,7 +1,10 @@
 #pragma once
 
+#include <vector>
 #include <iostream>
+#include <type_traits>
 
+#include "SympleCode/Util/Arena.h"
 #include "SympleCode/Util/ConsoleColor.h"
 #include "SympleCode/Syntax/Token.h"
 
@@ -11,14 +14,52 @@ namespace Symple::Syntax
 	{
 	public: enum Kind : unsigned;
 	protected:
-		shared_ptr<Token> mToken;
+		Token mToken;
+		// The one it was made in, null if it wasn't
+		Util::Arena* mArena = nullptr;
 
 		void PrintName(std::ostream& os = std::cout)
 		{ os << KindMap[GetKind()] << "Syntax"; }
+
+		// Children are linked by plain pointers, what's handed out shares ownership of the arena they're in
+		template<typename T>
+		static shared_ptr<T> Share(T* node)
+		{ return node ? shared_ptr<T>(static_cast<Node*>(node)->mArena->shared_from_this(), node) : nullptr; }
+
+		template<typename T>
+		static std::vector<shared_ptr<T>> Share(Util::ArenaArray<T*> nodes)
+		{
+			std::vector<shared_ptr<T>> shared;
+			shared.reserve(nodes.size());
+			for (T* node : nodes)
+				shared.push_back(Share(node));
+			return shared;
+		}
 	public:
-		Node(shared_ptr<Token> tok)
+		Node(Token tok)
 			: mToken(tok) {}
 
+		// Placed in the arena and never destroyed, it's freed along with it once nothing shares it anymore.
+		// Its children have to be from the same arena
+		template<typename T, typename... Args>
+		static shared_ptr<T> Make(const shared_ptr<Util::Arena>& arena, Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Nodes in an arena are never destroyed");
+
+			T* node = new (arena->Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+			static_cast<Node*>(node)->mArena = arena.get();
+			return shared_ptr<T>(arena, node);
+		}
+
+		template<typename T>
+		static Util::ArenaArray<T*> MakeList(Util::Arena& arena, const std::vector<shared_ptr<T>>& nodes)
+		{
+			Util::ArenaArray<T*> list(arena, nodes.size());
+			for (unsigned i = 0; i < list.size(); i++)
+				list[i] = nodes[i].get();
+			return list;
+		}
+
 		bool Is(Kind kind)
 		{ return GetKind() == kind; }
 		template <typename... Args>
@@ -28,7 +69,7 @@ namespace Symple::Syntax
 		virtual Kind GetKind()
 		{ return Unknown; }
 
-		shared_ptr<Token> GetToken()
+		Token GetToken()
 		{ return mToken; }
 
 		virtual void Print(std::ostream& os = std::cout, std::string_view indent = "", bool last = true, std::string_view label = "")
@@ -36,11 +77,11 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 
-			os.put('\n'); GetToken()->Print(os, std::string(indent) + GetAddIndent(last), true, "Token = ");
+			os.put('\n'); GetToken().Print(os, std::string(indent) + GetAddIndent(last), true, "Token = ");
 		}
 
 		virtual void PrintShort(std::ostream& os)
-		{ PrintName(os); os << ": "; GetToken()->PrintShort(os); }
+		{ PrintName(os); os << ": "; GetToken().PrintShort(os); }
 		
 		static void PrintIndent(std::ostream& os = std::cout, std::string_view indent = "", bool last = true, std::string_view label = "")
 		{
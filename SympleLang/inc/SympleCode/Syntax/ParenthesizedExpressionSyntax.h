@@ -7,11 +7,11 @@ namespace Symple::Syntax
 	class ParenthesizedExpressionSyntax : public ExpressionSyntax
 	{
 	private:
-		shared_ptr<ExpressionSyntax> mExpression;
-		shared_ptr<Token> mClose;
+		ExpressionSyntax* mExpression;
+		Token mClose;
 	public:
-		ParenthesizedExpressionSyntax(shared_ptr<Token> open, shared_ptr<ExpressionSyntax> expression, shared_ptr<Token> close)
-			: ExpressionSyntax(open), mExpression(expression), mClose(close) {}
+		ParenthesizedExpressionSyntax(Token open, shared_ptr<ExpressionSyntax> expression, Token close)
+			: ExpressionSyntax(open), mExpression(expression.get()), mClose(close) {}
 
 		virtual Kind GetKind() override
 		{ return ParenthesizedExpression; }
@@ -27,13 +27,13 @@ namespace Symple::Syntax
 			os.put('\n'); GetExpression()->Print(os, newIndent, true, "Expression = ");
 		}
 
-		shared_ptr<Token> GetOpen()
+		Token GetOpen()
 		{ return GetToken(); }
 
 		shared_ptr<ExpressionSyntax> GetExpression()
-		{ return mExpression; }
+		{ return Share(mExpression); }
 
-		shared_ptr<Token> GetClose()
+		Token GetClose()
 		{ return mClose; }
 	};
 }
\ No newline at end of file
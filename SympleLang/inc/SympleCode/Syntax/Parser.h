@@ -4,6 +4,7 @@
 
 #include "SympleCode/Syntax/Lexer.h"
 #include "SympleCode/Syntax/Token.h"
+#include "SympleCode/Syntax/TokenBuffer.h"
 
 #include "SympleCode/Syntax/Node.h"
 #include "SympleCode/Syntax/TranslationUnitSyntax.h"
@@ -37,21 +38,82 @@
 #include "SympleCode/Syntax/CallExpressionSyntax.h"
 
 #include "SympleCode/DiagnosticBag.h"
+#include "SympleCode/Util/Arena.h"
 
 namespace Symple::Syntax
 {
+	// Replaces Length bytes at Offset of a file with Text
+	struct TextEdit
+	{
+		unsigned Offset, Length;
+		std::string_view Text;
+	};
+
 	class __SYC_API Parser
 	{
 	private:
-		TokenList mTokens;
+		// Roughly how many tokens each thread is given to parse, below twice this it's parsed serially
+		static constexpr unsigned sParallelChunkSize = 1 << 15;
+		// Edits a reused token buffer is shifted through before the whole file is parsed again, see Reparse
+		static constexpr unsigned sMaxShifts = 64;
+
+		// One pending level of an expression, kept on the heap so deep nesting doesn't use the call stack
+		struct ExpressionFrame
+		{
+			enum Kind
+			{
+				Binary,
+				Unary,
+				Parenthesized,
+				Call,
+			} Kind;
+
+			// Binary frames stop at operators of this precedence or lower
+			unsigned Precedence;
+			// The operator, open parenthesis or called name
+			Token Start;
+			Token Open;
+			shared_ptr<ExpressionSyntax> Left;
+			ExpressionList Arguments;
+
+			ExpressionFrame(enum Kind kind, unsigned precedence = 0, Token start = {}, Token open = {})
+				: Kind(kind), Precedence(precedence), Start(start), Open(open) {}
+		};
+
+		// Only set while streaming, dropped once it hands out EndOfFile
+		shared_ptr<Lexer> mLexer;
+		shared_ptr<TokenBuffer> mTokens;
 		unsigned mPosition = 0;
 
-		std::vector<std::string> mStructNames;
+		std::vector<Util::Atom> mStructNames;
+		// Every node of the tree is allocated from this, whatever holds one of them keeps it alive
+		shared_ptr<Util::Arena> mArena = make_shared<Util::Arena>();
 		shared_ptr<DiagnosticBag> mDiagnosticBag = make_shared<DiagnosticBag>();
+
+		std::vector<ExpressionFrame> mExpressionFrames;
+		// Where each member parsed so far ends, see TranslationUnitSyntax
+		std::vector<unsigned> mMemberEnds;
+
+		// Only set when reparsing
+		shared_ptr<TranslationUnitSyntax> mPrevious;
+		TextEdit mEdit;
+
+		// Parses members from begin of the parent's tokens, knowing only the structs declared before it
+		Parser(Parser& parent, unsigned begin, std::vector<Util::Atom> structNames);
+
+		void ParseMembers(std::vector<shared_ptr<MemberSyntax>>&, unsigned end);
+		// Parses the members in chunks on the thread pool, false if the unit is too small or still streaming
+		bool ParseParallel(std::vector<shared_ptr<MemberSyntax>>&);
+		shared_ptr<TranslationUnitSyntax> Reparse();
 	public:
+		// Lexes on demand as the parser looks ahead
 		Parser(shared_ptr<Lexer>);
-		Parser(shared_ptr<Lexer>, TokenList);
-		Parser(TokenList);
+		// Parses tokens that are already lexed, the last must be EndOfFile
+		Parser(shared_ptr<TokenBuffer>);
+		// Parses the previous tree's text with the edit applied, only the members the edit touches are parsed again and
+		// the rest are reused as they are. The previous tree stays readable, but its tokens report where they are in the new
+		// text, so only the newest tree can be edited again
+		Parser(shared_ptr<TranslationUnitSyntax> previous, TextEdit);
 
 		shared_ptr<TranslationUnitSyntax> Parse();
 
@@ -78,22 +140,32 @@ namespace Symple::Syntax
 		shared_ptr<TypeSyntax> ParseType(shared_ptr<TypeSyntax> base = nullptr);
 
 		shared_ptr<ExpressionSyntax> ParseExpression();
-		ExpressionList ParseExpressionList();
 		shared_ptr<ExpressionSyntax> ParseUnaryExpression(unsigned parentPrecedence = 0);
 		shared_ptr<ExpressionSyntax> ParseBinaryExpression(unsigned parentPrecedence = 0);
 
 		shared_ptr<ExpressionSyntax> ParsePrimaryExpression();
 		shared_ptr<NameExpressionSyntax> ParseNameExpression();
-		shared_ptr<CallExpressionSyntax> ParseCallExpression();
 		shared_ptr<LiteralExpressionSyntax> ParseLiteralExpression();
 		shared_ptr<ParenthesizedExpressionSyntax> ParseParenthesizedExpression();
 
 		shared_ptr<DiagnosticBag> GetDiagnosticBag();
 	private:
-		shared_ptr<Token> Peek(unsigned off = 0);
-		shared_ptr<Token> Next();
-		shared_ptr<Token> Match(Token::Kind);
+		Token Peek(unsigned off = 0);
+		Token Next();
+		Token Match(Token::Kind);
 
 		bool IsType();
+
+		shared_ptr<ExpressionSyntax> ParseExpressionFrames(unsigned parentPrecedence, bool binary);
+		// Starts the next argument of the call on top of the stack, false once the list ends
+		bool ParseNextArgument(bool first);
+
+		template<typename T, typename... Args>
+		shared_ptr<T> Make(Args&&... args)
+		{ return Node::Make<T>(mArena, std::forward<Args>(args)...); }
+
+		template<typename T>
+		Util::ArenaArray<T*> MakeList(const std::vector<shared_ptr<T>>& nodes)
+		{ return Node::MakeList(*mArena, nodes); }
 	};
 }
\ No newline at end of file
@@ -8,10 +8,10 @@ namespace Symple::Syntax
 	class ReturnStatementSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<ExpressionSyntax> mValue;
+		ExpressionSyntax* mValue;
 	public:
-		ReturnStatementSyntax(shared_ptr<Token> tok, shared_ptr<ExpressionSyntax> val)
-			: StatementSyntax(tok), mValue(val) {}
+		ReturnStatementSyntax(Token tok, shared_ptr<ExpressionSyntax> val)
+			: StatementSyntax(tok), mValue(val.get()) {}
 
 		virtual Kind GetKind() override
 		{ return ReturnStatement; }
@@ -31,6 +31,6 @@ namespace Symple::Syntax
 		}
 
 		shared_ptr<ExpressionSyntax> GetValue()
-		{ return mValue; }
+		{ return Share(mValue); }
 	};
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Symple::Syntax
 	class StatementSyntax : public Node
 	{
 	public:
-		StatementSyntax(shared_ptr<Token> tok)
+		StatementSyntax(Token tok)
 			: Node(tok) {}
 
 		virtual Kind GetKind() override
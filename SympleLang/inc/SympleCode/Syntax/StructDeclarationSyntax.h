@@ -12,13 +12,13 @@ namespace Symple::Syntax
 	class StructDeclarationSyntax: public MemberSyntax
 	{
 	private:
-		shared_ptr<Token> mKeyword;
-		shared_ptr<Token> mOpenBrace;
-		VariableDeclarationList mMembers;
-		shared_ptr<Token> mCloseBrace;
+		Token mKeyword;
+		Token mOpenBrace;
+		Util::ArenaArray<VariableDeclarationSyntax*> mMembers;
+		Token mCloseBrace;
 	public:
-		StructDeclarationSyntax(shared_ptr<Token> keyword, shared_ptr<Token> name, shared_ptr<Token> openBrace,
-			VariableDeclarationList members, shared_ptr<Token> closeBrace)
+		StructDeclarationSyntax(Token keyword, Token name, Token openBrace,
+			Util::ArenaArray<VariableDeclarationSyntax*> members, Token closeBrace)
 			: MemberSyntax(name), mKeyword(keyword), mOpenBrace(openBrace), mMembers(members), mCloseBrace(closeBrace)
 		{}
 
@@ -30,7 +30,7 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 
-			os << " '" << GetName()->GetText() << "'";
+			os << " '" << GetName().GetText() << "'";
 
 			std::string newIndent(indent);
 			newIndent += GetAddIndent(last);
@@ -39,19 +39,19 @@ namespace Symple::Syntax
 			{ os.put('\n'); member->Print(os, newIndent, member == GetMembers().back(), "[Member] "); }
 		}
 
-		shared_ptr<Token> GetKeyword()
+		Token GetKeyword()
 		{ return mKeyword; }
 
-		shared_ptr<Token> GetName()
+		Token GetName()
 		{ return GetToken(); }
 
-		shared_ptr<Token> GetOpenBrace()
+		Token GetOpenBrace()
 		{ return mOpenBrace; }
 
 		VariableDeclarationList GetMembers()
-		{ return mMembers; }
+		{ return Share(mMembers); }
 
-		shared_ptr<Token> GetCloseBrace()
+		Token GetCloseBrace()
 		{ return mCloseBrace; }
 	};
 }
\ No newline at end of file
@@ -1,24 +1,24 @@
 #pragma once
 
+#include <vector>
+
 #include "SympleCode/Syntax/Trivia.h"
 
+#include "SympleCode/Util/Atom.h"
+
 namespace Symple::Syntax
 {
+	class TokenBuffer;
+
+	// Lightweight handle to a token stored in a TokenBuffer, the buffer must outlive it
 	class __SYC_API Token
 	{
 	public: enum Kind : unsigned;
 	private:
-		Kind mKind;
-		std::string mText;
-		shared_ptr<Trivia> mTrivia;
-
-		char* mFile;
-		unsigned mLine, mColumn;
+		TokenBuffer* mBuffer;
+		unsigned mIndex;
 	public:
-		Token(Kind = Unknown, shared_ptr<Trivia> = Trivia::Default, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
-		Token(Kind, std::string_view text, shared_ptr<Trivia> = Trivia::Default, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
-		Token(Kind, char* beg, unsigned len = 1, shared_ptr<Trivia> = Trivia::Default, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
-		Token(Kind, char* beg, char* end, shared_ptr<Trivia> = Trivia::Default, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
+		Token(TokenBuffer* = nullptr, unsigned index = 0);
 
 		bool IsKeyword();
 		bool Is(Kind kind);
@@ -31,14 +31,22 @@ namespace Symple::Syntax
 
 		Kind GetKind();
 		std::string_view GetText();
-		shared_ptr<Trivia> GetTrivia();
+		// Set for identifiers and strings, the empty atom otherwise
+		Util::Atom GetAtom();
+		Trivia GetTrivia();
 
-		char* GetFile();
+		const char* GetFile();
 		unsigned GetLine();
 		unsigned GetColumn();
 
-		static shared_ptr<Token> Error;
-		static shared_ptr<Token> Default;
+		TokenBuffer* GetBuffer();
+		unsigned GetIndex();
+
+		bool operator ==(const Token&) const;
+		bool operator !=(const Token&) const;
+
+		static Token Error;
+		static Token Default;
 	public:
 		enum Kind : unsigned
 		{
@@ -184,5 +192,5 @@ namespace Symple::Syntax
 		};
 	};
 
-	typedef std::vector<shared_ptr<Token>> TokenList;
+	typedef std::vector<Token> TokenList;
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "SympleCode/Syntax/Token.h"
+
+#include "SympleCode/Util/Atom.h"
+#include "SympleCode/Util/FileUtil.h"
+
+namespace Symple::Syntax
+{
+	// Every token lexed from one file, stored as parallel arrays and addressed by index.
+	// Always owned by a shared_ptr, so anything keeping its tokens around can keep it alive
+	class __SYC_API TokenBuffer : public std::enable_shared_from_this<TokenBuffer>
+	{
+	private:
+		shared_ptr<Util::MappedFile> mSourceFile;
+		// Set once rebased, positions are reported in this instead
+		shared_ptr<Util::MappedFile> mEditedFile;
+		std::string mFile;
+
+		std::vector<unsigned char> mKinds;
+		std::vector<unsigned> mOffsets;
+		std::vector<unsigned> mLengths;
+		std::vector<unsigned char> mTriviaKinds;
+		std::vector<unsigned> mTriviaOffsets;
+		std::vector<unsigned> mTriviaLengths;
+		std::vector<unsigned> mAtoms;
+		// Edits applied on top of the stored offsets in order, offsets at or after the first move by the second
+		std::vector<std::pair<unsigned, int>> mShifts;
+
+		static_assert(Token::Last <= 0xFF, "Token kinds no longer fit in a byte");
+		static_assert(Trivia::Length <= 8, "Trivia kinds no longer fit in a byte");
+	public:
+		TokenBuffer(char* file, shared_ptr<Util::MappedFile> sourceFile);
+
+		TokenBuffer(const TokenBuffer&) = delete;
+		TokenBuffer& operator =(const TokenBuffer&) = delete;
+
+		Token Add(Token::Kind, unsigned offset, unsigned length, Trivia::Kind, unsigned triviaOffset, unsigned triviaLength, Util::Atom = {});
+		// Both buffers must be over the same source
+		void Append(TokenBuffer&);
+		void SetTrivia(unsigned index, Trivia::Kind, unsigned offset, unsigned length);
+		void Reserve(unsigned count);
+		// Moves the tokens onto an edited copy of the source, the ones at or after from shift by delta.
+		// Only where they're reported to be changes, their text still comes from the source they were lexed from
+		void Rebase(shared_ptr<Util::MappedFile> sourceFile, unsigned from, int delta);
+		unsigned GetShiftCount();
+
+		Token Get(unsigned index);
+		Token GetBack();
+		unsigned GetCount();
+
+		Token::Kind GetKind(unsigned index);
+		std::string_view GetText(unsigned index);
+		Trivia GetTrivia(unsigned index);
+		unsigned GetOffset(unsigned index);
+		unsigned GetTriviaOffset(unsigned index);
+		Util::Atom GetAtom(unsigned index);
+		// 1-based, resolved from the offset
+		unsigned GetLine(unsigned index);
+		unsigned GetColumn(unsigned index);
+
+		char* GetFile();
+		// The latest text the offsets are in, the text the tokens were lexed from lives as long as the buffer
+		shared_ptr<Util::MappedFile> GetSourceFile();
+	private:
+		unsigned Shift(unsigned offset);
+	};
+}
@@ -3,15 +3,26 @@
 #include "SympleCode/Syntax/Node.h"
 #include "SympleCode/Syntax/MemberSyntax.h"
 
+#include "SympleCode/Syntax/TokenBuffer.h"
+
 namespace Symple::Syntax
 {
 	class TranslationUnitSyntax : public Node
 	{
 	private:
+		// Each shares the arena it's in, so the arenas live as long as any node from them is held
 		std::vector<shared_ptr<MemberSyntax>> mMembers;
+		// Where each member's text ends, each starts where the one before it ended (with its leading trivia)
+		std::vector<unsigned> mMemberEnds;
+		// Every token in the tree points into one of these
+		std::vector<shared_ptr<TokenBuffer>> mTokens;
+		// Which of those each member was parsed from, empty if there's only one
+		std::vector<TokenBuffer*> mMemberTokens;
 	public:
-		TranslationUnitSyntax(std::vector<shared_ptr<MemberSyntax>>& members, shared_ptr<Token> eof)
-			: Node(eof), mMembers(members) {}
+		TranslationUnitSyntax(std::vector<shared_ptr<MemberSyntax>>& members, Token eof, std::vector<shared_ptr<TokenBuffer>> tokens = {},
+			std::vector<unsigned> memberEnds = {}, std::vector<TokenBuffer*> memberTokens = {})
+			: Node(eof), mMembers(members), mMemberEnds(std::move(memberEnds)), mTokens(std::move(tokens)),
+				mMemberTokens(std::move(memberTokens)) {}
 
 		virtual Kind GetKind() override
 		{ return TranslationUnit; }
@@ -30,5 +41,14 @@ namespace Symple::Syntax
 
 		std::vector<shared_ptr<MemberSyntax>> GetMembers()
 		{ return mMembers; }
+
+		std::vector<unsigned>& GetMemberEnds()
+		{ return mMemberEnds; }
+
+		std::vector<shared_ptr<TokenBuffer>>& GetTokens()
+		{ return mTokens; }
+
+		TokenBuffer* GetMemberTokens(unsigned member)
+		{ return mMemberTokens.empty() ? mTokens.front().get() : mMemberTokens[member]; }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "SympleCode/Syntax/TranslationUnitSyntax.h"
+#include "SympleCode/Util/Arena.h"
+#include "SympleCode/Util/FileUtil.h"
+
+namespace Symple::Syntax
+{
+	// Binary copy of a parsed file and the tokens it points into, kept next to the build output so an unchanged file
+	// doesn't have to be lexed and parsed again. Entries are checked against the source's hash and their own,
+	// anything from another version, another source or that is cut short is ignored
+	class __SYC_API TreeCache
+	{
+	private:
+		static constexpr char sMagic[4] = { 'S', 'Y', 'A', 'T' };
+		static constexpr unsigned sVersion = 1;
+		static constexpr unsigned char sNull = 0xFF;
+
+		std::string mData;
+		unsigned mPosition = 0;
+		bool mFailed = false;
+
+		TokenBuffer* mTokens = nullptr;
+		shared_ptr<Util::Arena> mArena;
+		// Nodes read so far that don't have a parent yet
+		std::vector<shared_ptr<Node>> mNodes;
+
+		template<typename T>
+		void Write(T);
+		void Write(Token);
+		void WriteTree(shared_ptr<TranslationUnitSyntax>);
+		void WriteNode(shared_ptr<Node>);
+		// In the order they're written, null for missing optional ones
+		void GetChildren(shared_ptr<Node>, std::vector<shared_ptr<Node>>&);
+
+		template<typename T>
+		T Read();
+		Token ReadToken();
+		shared_ptr<TranslationUnitSyntax> ReadTree(shared_ptr<TokenBuffer>);
+		shared_ptr<Node> ReadNode(Node::Kind);
+
+		template<typename T>
+		shared_ptr<T> Pop(bool optional = false);
+		template<typename T>
+		std::vector<shared_ptr<T>> PopList(unsigned count);
+		template<typename T, typename... Args>
+		shared_ptr<T> Make(Args&&...);
+	public:
+		// Null if there's no usable entry for this exact source
+		static shared_ptr<TranslationUnitSyntax> Load(char* path, char* file, shared_ptr<Util::MappedFile> source);
+		// Only trees parsed in one go from a single token buffer can be stored
+		static bool Store(char* path, shared_ptr<TranslationUnitSyntax>);
+
+		// 64-bit FNV-1a
+		static uint64_t Hash(std::string_view);
+	};
+}
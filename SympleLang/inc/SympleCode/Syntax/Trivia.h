@@ -7,20 +7,15 @@
 
 namespace Symple::Syntax
 {
+	// Whitespace in front of a token, stored inline in the TokenBuffer and rebuilt on request
 	class __SYC_API Trivia
 	{
 	public: typedef unsigned Kind;
 	private:
 		Kind mKind;
-		std::string mText;
-
-		char* mFile;
-		unsigned mLine, mColumn;
+		std::string_view mText; // Points into the source file
 	public:
-		Trivia(Kind = Unknown, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
-		Trivia(Kind, std::string_view text, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
-		Trivia(Kind, char* beg, unsigned len = 1, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
-		Trivia(Kind, char* beg, char* end, unsigned ln = 0, unsigned col = 0, char* file = "<NA>");
+		Trivia(Kind = Unknown, std::string_view text = "");
 
 		bool Is(Kind kind);
 		template <typename... Args>
@@ -33,12 +28,9 @@ namespace Symple::Syntax
 		Kind GetKind();
 		std::string_view GetText();
 
-		char* GetFile();
-		unsigned GetLine();
-		unsigned GetColumn();
-
-		static shared_ptr<Trivia> Error;
-		static shared_ptr<Trivia> Default;
+		// Shared immutable instances for the two most common cases, handed out by copy
+		static const Trivia None;
+		static const Trivia Space;
 	public:
 		enum _Kind : unsigned
 		{
@@ -7,10 +7,10 @@ namespace Symple::Syntax
 	class TypeReferenceSyntax : public TypeSyntax
 	{
 	private:
-		shared_ptr<TypeSyntax> mBase;
+		TypeSyntax* mBase;
 	public:
-		TypeReferenceSyntax(shared_ptr<Token> name, shared_ptr<TypeSyntax> base)
-			: TypeSyntax(name), mBase(base) {}
+		TypeReferenceSyntax(Token name, shared_ptr<TypeSyntax> base)
+			: TypeSyntax(name), mBase(base.get()) {}
 
 		virtual Kind GetKind() override
 		{ return TypeReference; }
@@ -38,6 +38,6 @@ namespace Symple::Syntax
 		}
 
 		shared_ptr<TypeSyntax> GetBase()
-		{ return mBase; }
+		{ return Share(mBase); }
 	};
 }
\ No newline at end of file
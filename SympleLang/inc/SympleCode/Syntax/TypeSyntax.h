@@ -7,16 +7,16 @@ namespace Symple::Syntax
 	class TypeSyntax : public Node
 	{
 	public:
-		TypeSyntax(shared_ptr<Token> name)
+		TypeSyntax(Token name)
 			: Node(name) {}
 
 		virtual Kind GetKind() override
 		{ return Type; }
 
 		virtual void PrintShort(std::ostream& os = std::cout)
-		{ os << GetName()->GetText(); }
+		{ os << GetName().GetText(); }
 
-		shared_ptr<Token> GetName()
+		Token GetName()
 		{ return GetToken(); }
 	};
 }
\ No newline at end of file
@@ -7,10 +7,10 @@ namespace Symple::Syntax
 	class UnaryExpressionSyntax : public ExpressionSyntax
 	{
 	private:
-		shared_ptr<ExpressionSyntax> mOperand;
+		ExpressionSyntax* mOperand;
 	public:
-		UnaryExpressionSyntax(shared_ptr<Token> op, shared_ptr<ExpressionSyntax> operand)
-			: ExpressionSyntax(op), mOperand(operand) {}
+		UnaryExpressionSyntax(Token op, shared_ptr<ExpressionSyntax> operand)
+			: ExpressionSyntax(op), mOperand(operand.get()) {}
 
 		virtual Kind GetKind()
 		{ return UnaryExpression; }
@@ -20,7 +20,7 @@ namespace Symple::Syntax
 			PrintIndent(os, indent, last, label);
 			PrintName(os);
 			os << " [";
-			GetOperator()->PrintShort(os);
+			GetOperator().PrintShort(os);
 			os.put(']');
 
 			std::string newIndent(indent);
@@ -29,10 +29,10 @@ namespace Symple::Syntax
 			os.put('\n'); GetOperand()->Print(os, newIndent, true, "Operand = ");
 		}
 
-		shared_ptr<Token> GetOperator()
+		Token GetOperator()
 		{ return GetToken(); }
 
 		shared_ptr<ExpressionSyntax> GetOperand()
-		{ return mOperand; }
+		{ return Share(mOperand); }
 	};
 }
\ No newline at end of file
@@ -11,12 +11,12 @@ namespace Symple::Syntax
 	class VariableDeclarationSyntax : public StatementSyntax
 	{
 	private:
-		shared_ptr<TypeSyntax> mType;
-		shared_ptr<Token> mEquals;
-		shared_ptr<ExpressionSyntax> mInitializer;
+		TypeSyntax* mType;
+		Token mEquals;
+		ExpressionSyntax* mInitializer;
 	public:
-		VariableDeclarationSyntax(shared_ptr<TypeSyntax> type, shared_ptr<Token> name, shared_ptr<Token> equals, shared_ptr<ExpressionSyntax> initializer)
-			: StatementSyntax(name), mType(type), mEquals(equals), mInitializer(initializer) {}
+		VariableDeclarationSyntax(shared_ptr<TypeSyntax> type, Token name, Token equals, shared_ptr<ExpressionSyntax> initializer)
+			: StatementSyntax(name), mType(type.get()), mEquals(equals), mInitializer(initializer.get()) {}
 
 		virtual Kind GetKind() override
 		{ return VariableDeclaration; }
@@ -28,7 +28,7 @@ namespace Symple::Syntax
 
 			os << " '"; GetType()->PrintShort(os);
 			if (GetName() != Token::Default)
-				os << ' ' << GetName()->GetText();
+				os << ' ' << GetName().GetText();
 			os.put('\'');
 
 			if (GetInitializer())
@@ -44,20 +44,20 @@ namespace Symple::Syntax
 		{
 			GetType()->PrintShort();
 			if (GetName() != Token::Default)
-				os << ' ' << GetName()->GetText();
+				os << ' ' << GetName().GetText();
 		}
 
-		shared_ptr<Token> GetName()
+		Token GetName()
 		{ return GetToken(); }
 
 		shared_ptr<TypeSyntax> GetType()
-		{ return mType; }
+		{ return Share(mType); }
 
-		shared_ptr<Token> GetEquals()
+		Token GetEquals()
 		{ return mEquals; }
 
 		shared_ptr<ExpressionSyntax> GetInitializer()
-		{ return mInitializer; }
+		{ return Share(mInitializer); }
 	};
 
 	typedef std::vector<shared_ptr<VariableDeclarationSyntax>> VariableDeclarationList;
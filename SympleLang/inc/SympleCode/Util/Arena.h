@@ -0,0 +1,90 @@
+#pragma once
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "SympleCode/Memory.h"
+
+namespace Symple::Util
+{
+	// Bump allocator, memory is handed out of large blocks that are all freed at once when it is destroyed.
+	// Nothing allocated from it is ever destroyed, so it may only hold what needs no destructor.
+	// Not thread safe, give each thread its own
+	class __SYC_API Arena : public std::enable_shared_from_this<Arena>
+	{
+	private:
+		static constexpr size_t sBlockSize = 64 * 1024;
+
+		std::vector<char*> mBlocks;
+		char* mCurrent = nullptr;
+		char* mEnd = nullptr;
+		size_t mAllocatedBytes = 0;
+		// Whatever the memory points into
+		std::vector<shared_ptr<void>> mKeptAlive;
+
+		void* AllocateBlock(size_t size, size_t align);
+	public:
+		Arena() = default;
+		~Arena();
+
+		Arena(const Arena&) = delete;
+		Arena& operator =(const Arena&) = delete;
+
+		void* Allocate(size_t size, size_t align = alignof(std::max_align_t))
+		{
+			char* ptr = (char*)(((size_t)mCurrent + align - 1) & ~(align - 1));
+			if (!mCurrent || ptr + size > mEnd)
+				return AllocateBlock(size, align);
+
+			mCurrent = ptr + size;
+			mAllocatedBytes += size;
+			return ptr;
+		}
+
+		// Lives as long as the arena, for what's allocated from it to point into
+		void KeepAlive(shared_ptr<void> owner)
+		{ mKeptAlive.push_back(std::move(owner)); }
+
+		size_t GetAllocatedBytes()
+		{ return mAllocatedBytes; }
+	};
+
+	// Fixed number of elements allocated from an arena, copied around without owning them
+	template<typename T>
+	class ArenaArray
+	{
+	private:
+		static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+
+		T* mData = nullptr;
+		unsigned mSize = 0;
+	public:
+		ArenaArray() = default;
+
+		ArenaArray(Arena& arena, unsigned size)
+			: mData(size ? (T*)arena.Allocate(sizeof(T) * size, alignof(T)) : nullptr), mSize(size)
+		{
+			for (unsigned i = 0; i < size; i++)
+				new (mData + i) T();
+		}
+
+		ArenaArray(Arena& arena, const std::vector<T>& elements)
+			: ArenaArray(arena, elements.size())
+		{ std::copy(elements.begin(), elements.end(), mData); }
+
+		T* begin()
+		{ return mData; }
+
+		T* end()
+		{ return mData + mSize; }
+
+		unsigned size()
+		{ return mSize; }
+
+		T& operator [](unsigned index)
+		{ return mData[index]; }
+	};
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string_view>
+#include <functional>
+
+#include "SympleCode/Memory.h"
+
+namespace Symple::Util
+{
+	// Id of an interned string, two atoms are equal exactly when their text is.
+	// Atoms are never freed, so their text lives for the rest of the program
+	class __SYC_API Atom
+	{
+	private:
+		unsigned mId = 0;
+	public:
+		// The empty string
+		Atom() = default;
+		// Interns text, safe to call from any thread
+		Atom(std::string_view text);
+		Atom(const char* text)
+			: Atom(std::string_view(text)) {}
+
+		unsigned GetId() const
+		{ return mId; }
+
+		// Null terminated
+		std::string_view GetText() const;
+
+		bool operator ==(const Atom& other) const
+		{ return mId == other.mId; }
+
+		bool operator !=(const Atom& other) const
+		{ return mId != other.mId; }
+
+		static Atom FromId(unsigned id);
+	};
+}
+
+template<>
+struct std::hash<Symple::Util::Atom>
+{
+	size_t operator ()(const Symple::Util::Atom& atom) const
+	{ return std::hash<unsigned>()(atom.GetId()); }
+};
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <mutex>
 #include <cstdio>
 #include <string>
+#include <vector>
+#include <string_view>
 
 namespace Symple::Util
 {
@@ -11,4 +14,38 @@ namespace Symple::Util
 
 	void DumpFile(FILE* from, FILE* to = stdout);
 	std::string ReadFile(FILE*, unsigned max = -1);
+
+	// Read-only view of a whole file, memory mapped so the contents are never copied
+	class MappedFile
+	{
+	private:
+		std::string mBuffer; // Backing store when the file can't be mapped (or for in-memory sources)
+		char* mData;
+		unsigned mSize = 0;
+
+		// Offset of each line's first byte, built on first lookup since only diagnostics need it
+		std::vector<unsigned> mLineStarts;
+		std::once_flag mLineStartsFlag;
+
+#if _WIN32
+		void* mFileHandle = nullptr;
+		void* mMappingHandle = nullptr;
+#else
+		bool mMapped = false;
+#endif
+	public:
+		MappedFile(char* path);
+		MappedFile(std::string_view text);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator =(const MappedFile&) = delete;
+
+		bool IsMapped();
+
+		char* GetData();
+		unsigned GetSize();
+		std::string_view GetText();
+		std::vector<unsigned>& GetLineStarts();
+	};
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+namespace Symple::Util
+{
+	enum ScanLevel : unsigned
+	{
+		ScalarScan,
+		SSE2Scan,
+		AVX2Scan,
+	};
+
+	// Best level the CPU supports, detected once
+	ScanLevel GetSupportedScanLevel();
+	ScanLevel GetScanLevel();
+	// Clamped to the supported level, lets the vector paths be compared against the scalar one
+	void SetScanLevel(ScanLevel);
+	char* GetScanLevelName(ScanLevel);
+
+	// Each scan starts at pos and returns the position of the first byte that ends the run (or length)
+
+	// Skips ' ', '\t', '\r' and '\n', counting the new lines
+	unsigned ScanWhiteSpace(char* data, unsigned pos, unsigned length, unsigned& newLines);
+	// Skips [a-zA-Z0-9_$]
+	unsigned ScanIdentifier(char* data, unsigned pos, unsigned length);
+	// Finds the next c
+	unsigned ScanUntil(char* data, unsigned pos, unsigned length, char c);
+
+	// Appends the offset just past every '\n'
+	void ScanLineStarts(char* data, unsigned length, std::vector<unsigned>& lineStarts);
+}
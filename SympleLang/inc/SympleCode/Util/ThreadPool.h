@@ -0,0 +1,72 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include "SympleCode/Memory.h"
+
+namespace Symple::Util
+{
+	// Fixed set of worker threads that run jobs in the order they are submitted. Anything waiting on a job through Wait
+	// runs its own queued subtasks in the meantime, so jobs can wait on the jobs they submit without tying up every worker
+	class __SYC_API ThreadPool
+	{
+	private:
+		struct Job
+		{
+			std::function<void()> Run;
+			// The job or thread that submitted it, only that one runs it while waiting
+			uint64_t Owner;
+			uint64_t Id;
+		};
+
+		std::vector<std::thread> mThreads;
+		std::deque<Job> mJobs;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		// Signalled whenever a job finishes, counted so a waiter can't miss one
+		std::condition_variable mFinishedCondition;
+		uint64_t mFinished = 0;
+		bool mStopping = false;
+
+		void Work();
+		void Run(Job&);
+		void Push(std::function<void()>);
+		// Returns once ready does, running this thread's own queued subtasks until then
+		void WaitUntil(std::function<bool()> ready);
+	public:
+		ThreadPool(unsigned threadCount = std::thread::hardware_concurrency());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator =(const ThreadPool&) = delete;
+
+		template<typename F>
+		std::future<std::invoke_result_t<F>> Submit(F job)
+		{
+			auto task = make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::move(job));
+			auto future = task->get_future();
+			Push([task]() { (*task)(); });
+			return future;
+		}
+
+		template<typename T>
+		T Wait(std::future<T>& future)
+		{
+			WaitUntil([&future]() { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+			return future.get();
+		}
+
+		unsigned GetThreadCount();
+
+		// Shared by the whole compiler, one thread per core
+		static ThreadPool& Get();
+	};
+}
@@ -14,35 +14,44 @@
 
 #include "SympleCode/Compiler.h"
 
+#include "SympleCode/Util/ThreadPool.h"
+
 namespace Symple::Binding
 {
+	Binder::Binder(shared_ptr<CompilationContext> context)
+		: mContext(context)
+	{}
+
+	Binder::Binder(Binder& parent, const Symbol::SymbolTable& globals)
+		: mContext(parent.mContext), mCompilationUnit(parent.mCompilationUnit), mStructures(parent.mStructures), mFunctions(parent.mFunctions), mScope(&globals)
+	{}
+
 	void Binder::BeginScope()
-	{ mScope = make_shared<BoundScope>(mScope); }
+	{ mScope.BeginScope(); }
 
 	void Binder::EndScope()
-	{ mScope = mScope->GetBase(); }
-
-	std::unordered_map<std::string, shared_ptr<BoundCompilationUnit>> Binder::sImportedSymbols;
+	{ mScope.EndScope(); }
 
 	shared_ptr<BoundCompilationUnit> Binder::BindImport(shared_ptr<Syntax::ImportStatementSyntax> syntax)
 	{
-		std::string path = syntax->GetImport()->GetFile();
-		path = path.substr(0, path.find_last_of('/') + 1);
-		path += syntax->GetImport()->GetText();
-		for (auto symbol : sImportedSymbols)
-			if (path == symbol.first)
-			{
-				auto unit = symbol.second;
+		std::string path = GetImportPath(syntax);
+		mImports.push_back({ path, std::string(syntax->GetImport().GetText()) });
+		return BindImport(path, syntax->GetImport().GetText(), syntax);
+	}
 
-				for (auto s : unit->GetStructures())
-					mStructures.push_back(s);
-				for (auto fn : unit->GetFunctions())
-					mFunctions.push_back({ fn.first, nullptr });
-				return unit;
-			}
-		for (auto symbol : Compiler::sLibraries)
-			if (path == symbol)
-				return make_shared<BoundCompilationUnit>(syntax, StructMap(), FunctionMap());
+	shared_ptr<BoundCompilationUnit> Binder::BindImport(std::string path, std::string_view name, shared_ptr<Syntax::Node> syntax)
+	{
+		if (auto unit = mContext->GetImport(path))
+		{
+			for (auto s : unit->GetStructures())
+				mStructures->push_back(s);
+			for (auto fn : unit->GetFunctions())
+				mFunctions->push_back({ fn.first, nullptr });
+			return unit;
+		}
+
+		if (mContext->IsLibrary(path))
+			return make_shared<BoundCompilationUnit>(syntax, StructMap(), FunctionMap());
 		
 		if (_access(path.c_str(), 0) != -1)
 		{
@@ -50,30 +59,30 @@ namespace Symple::Binding
 			Util::SetConsoleColor(Util::Cyan);
 			spdlog::info("Import '{}'", path);
 			Util::SetConsoleColor(col);
-			unique_ptr<Symple::Compiler> compiler = make_unique<Symple::Compiler>((char*)path.c_str());
-			compiler->Lex();
-			compiler->Parse();
-			compiler->Bind();
-			compiler->Emit();
-			compiler->Compile();
+			auto compiler = make_shared<Symple::Compiler>((char*)path.c_str(), mContext);
+			auto unit = Symple::Compiler::CompileImport(compiler);
+			if (!unit)
+			{
+				spdlog::error("Failed to import '{}'", path);
+				return make_shared<BoundCompilationUnit>(syntax, StructMap(), FunctionMap());
+			}
 			col = Util::GetConsoleColor();
 			Util::SetConsoleColor(Util::Cyan);
 			spdlog::info("Imported '{}'", path);
 			Util::SetConsoleColor(col);
 
-			auto unit = compiler->mTree;
-			Symple::Compiler::sUnits.push_back(compiler->mAsmPath);
-			sImportedSymbols.insert({ path, unit });
+			mContext->AddUnit(compiler->mAsmPath);
+			mContext->AddImport(path, unit);
 
 			for (auto s : unit->GetStructures())
-				mStructures.push_back(s);
+				mStructures->push_back(s);
 			for (auto fn : unit->GetFunctions())
-				mFunctions.push_back({ fn.first, nullptr });
+				mFunctions->push_back({ fn.first, nullptr });
 			return unit;
 		}
 		else
 		{
-			Compiler::sLibraries.push_back(std::string(syntax->GetImport()->GetText()));
+			mContext->AddLibrary(name);
 			return make_shared<BoundCompilationUnit>(syntax, StructMap(), FunctionMap());
 		}
 	}
@@ -81,9 +90,10 @@ namespace Symple::Binding
 	shared_ptr<BoundCompilationUnit> Binder::BindSymbols(shared_ptr<Syntax::TranslationUnitSyntax> unit)
 	{
 		mCompilationUnit = unit;
-		mStructures.clear();
-		mFunctions.clear();
-		mScope.reset();
+		mStructures->clear();
+		mFunctions->clear();
+		mImports.clear();
+		mScope.Clear();
 		BeginScope();
 
 		for (auto member : mCompilationUnit->GetMembers())
@@ -91,107 +101,121 @@ namespace Symple::Binding
 
 		EndScope();
 
-		return make_shared<BoundCompilationUnit>(unit, mStructures, mFunctions);
+		return make_shared<BoundCompilationUnit>(unit, *mStructures, *mFunctions);
 	}
 
 	shared_ptr<BoundCompilationUnit> Binder::Bind(shared_ptr<Syntax::TranslationUnitSyntax> unit)
 	{
 		mCompilationUnit = unit;
-		mStructures.clear();
-		mFunctions.clear();
-		mScope.reset();
+		mStructures->clear();
+		mFunctions->clear();
+		mImports.clear();
+		mScope.Clear();
 		BeginScope();
 
-		for (auto member : mCompilationUnit->GetMembers())
-			BindMember(member);
+		// Every declaration first, in order, so calls, fields and types resolve wherever they're bound.
+		// Each member gets its own bag to keep the diagnostics in source order
+		shared_ptr<DiagnosticBag> diagnostics = mDiagnosticBag;
+		auto members = mCompilationUnit->GetMembers();
+		std::vector<shared_ptr<DiagnosticBag>> memberDiagnostics;
+		std::vector<unsigned> functionIndices;
+		for (auto member : members)
+		{
+			mDiagnosticBag = make_shared<DiagnosticBag>();
+			memberDiagnostics.push_back(mDiagnosticBag);
+			functionIndices.push_back(mFunctions->size());
 
-		EndScope();
+			if (member->GetKind() != Syntax::Node::GlobalStatement)
+				BindMemberSymbol(member);
+		}
 
-		CheckMemberPromises();
-		CheckFunctionPromises();
+		// Then global statements in order, function bodies see the globals declared before them
+		std::vector<FunctionBody> bodies;
+		shared_ptr<Symbol::SymbolTable> globals;
+		for (unsigned i = 0; i < members.size(); i++)
+		{
+			mDiagnosticBag = memberDiagnostics[i];
+			if (members[i]->GetKind() == Syntax::Node::FunctionDeclaration)
+			{
+				if (!globals)
+					globals = make_shared<Symbol::SymbolTable>(mScope);
 
-		return make_shared<BoundCompilationUnit>(unit, mStructures, mFunctions);
-	}
+				unsigned index = functionIndices[i];
+				bodies.push_back({ dynamic_pointer_cast<Syntax::FunctionDeclarationSyntax>(members[i]), (*mFunctions)[index].first, index, globals, mDiagnosticBag });
+			}
+			else if (members[i]->GetKind() == Syntax::Node::GlobalStatement)
+			{
+				globals = nullptr;
+				BindMember(members[i]);
+			}
+		}
+		mDiagnosticBag = diagnostics;
 
+		BindFunctionBodies(bodies);
+		for (auto bag : memberDiagnostics)
+			mDiagnosticBag->Append(*bag);
 
-	void Binder::CheckGotoPromises()
-	{
-		for (auto promise : mGotoPromises)
-		{
-			for (auto label : mLabels)
-				if (label->GetLabel() == promise->GetPrompt()->GetLabel()->GetText())
-				{
-					promise->Complete(label);
-					break;
-				}
+		EndScope();
 
-			if (promise->IsBroken())
-				mDiagnosticBag->ReportUndeclaredLabel(promise->GetPrompt()->GetLabel());
-		}
+		return make_shared<BoundCompilationUnit>(unit, *mStructures, *mFunctions);
 	}
 
-	void Binder::CheckMemberPromises()
+
+	void Binder::BindFunctionBodies(std::vector<FunctionBody>& bodies)
 	{
-		for (auto promise : mMemPromises)
+		// Bodies only read what the declarations made, so each is bound on its own binder and merged back in order
+		std::vector<unique_ptr<Binder>> binders;
+		for (auto& body : bodies)
+			binders.push_back(unique_ptr<Binder>(new Binder(*this, *body.Globals)));
+
+		auto bind = [&bodies, &binders](unsigned i)
 		{
-			auto ztruct = dynamic_pointer_cast<Symbol::StructTypeSymbol>(promise->GetPrompt().first->GetType());
-			if (ztruct)
-				for (auto member : ztruct->GetMembers())
-					if (promise->GetPrompt().second->GetRight()->GetToken()->GetText() == member->GetName())
-					{
-						promise->Complete(member);
-						break;
-					}
+			FunctionBody& body = bodies[i];
+			return binders[i]->BindFunctionBody(body.Function, body.Declaration->GetBody());
+		};
+
+		std::vector<shared_ptr<BoundStatement>> results(bodies.size());
+		if (bodies.size() < 2 || Util::ThreadPool::Get().GetThreadCount() < 2)
+			for (unsigned i = 0; i < bodies.size(); i++)
+				results[i] = bind(i);
+		else
+		{
+			std::vector<std::future<shared_ptr<BoundStatement>>> jobs;
+			for (unsigned i = 1; i < bodies.size(); i++)
+				jobs.push_back(Util::ThreadPool::Get().Submit([&bind, i]() { return bind(i); }));
+			results[0] = bind(0);
+			for (unsigned i = 1; i < bodies.size(); i++)
+				results[i] = Util::ThreadPool::Get().Wait(jobs[i - 1]);
+		}
 
-			if (promise->IsBroken())
-				mDiagnosticBag->ReportBindError(promise->GetPrompt().second);
+		for (unsigned i = 0; i < bodies.size(); i++)
+		{
+			(*mFunctions)[bodies[i].Index].second = results[i];
+			bodies[i].Diagnostics->Append(*binders[i]->mDiagnosticBag);
 		}
 	}
 
-	void Binder::CheckFunctionPromises()
+	void Binder::DeclareLabels(shared_ptr<Syntax::StatementSyntax> syntax)
 	{
-		for (auto promise : mFuncPromises)
-		{
-			auto syntax = promise->GetPrompt();
-
-			shared_ptr<Symbol::FunctionSymbol> funcSymbol = FindFunction(mFunctions, syntax->GetName()->GetText());
-			ExpressionList args;
-			if (funcSymbol)
-			{
-				if (syntax->GetArguments().size() > funcSymbol->GetParameters().size())
-					mDiagnosticBag->ReportTooManyArguments(syntax, funcSymbol->GetParameters().size());
-				else
-					for (unsigned i = 0; i < funcSymbol->GetParameters().size(); i++)
-					{
-						shared_ptr<BoundExpression> arg = make_shared<BoundConstantExpression>(funcSymbol->GetParameters()[i]->GetInitializer());
-						if (i < syntax->GetArguments().size())
-						{
-							auto boundArg = BindExpression(syntax->GetArguments()[i]);
-							if (boundArg->GetKind() == Node::DefaultExpression)
-							{
-								if (!arg->ConstantValue())
-								{
-									mDiagnosticBag->ReportNoDefaultArgument(syntax, i);
-									break;
-								}
-							}
-							else
-								arg = boundArg;
-						}
-						else if (!arg->ConstantValue())
-						{
-							mDiagnosticBag->ReportTooFewArguments(syntax);
-							break;
-						}
+		if (!syntax)
+			return;
 
-						args.push_back(arg);
-					}
-
-				auto pair = std::pair(funcSymbol, args);
-				promise->Complete(pair);
-			}
-			else
-				mDiagnosticBag->ReportNoSuchFunction(syntax);
+		switch (syntax->GetKind())
+		{
+		case Syntax::Node::Label:
+			BindLabelSymbol(dynamic_pointer_cast<Syntax::LabelSyntax>(syntax));
+			break;
+		case Syntax::Node::BlockStatement:
+			for (auto statement : dynamic_pointer_cast<Syntax::BlockStatementSyntax>(syntax)->GetStatements())
+				DeclareLabels(statement);
+			break;
+		case Syntax::Node::IfStatement:
+		{
+			auto ifStatement = dynamic_pointer_cast<Syntax::IfStatementSyntax>(syntax);
+			DeclareLabels(ifStatement->GetThen());
+			DeclareLabels(ifStatement->GetElse());
+			break;
+		}
 		}
 	}
 
@@ -200,7 +224,7 @@ namespace Symple::Binding
 
 #define TYPE_CONT(name) \
 		case Syntax::Token::##name##Keyword: \
-			return make_shared<Symbol::TypeSymbol>(Symbol::TypeSymbol::##name##Type->GetTypeKind(), Symbol::TypeSymbol::##name##Type->GetName(), Symbol::TypeSymbol::##name##Type->GetSize(), Symbol::TypeSymbol::##name##Type->IsFloat(), pointerCount)
+			return mContext->GetPointerType(Symbol::TypeSymbol::##name##Type, pointerCount)
 
 #define TYPE_CASE(name) \
 		case Syntax::Token::##name##Keyword: \
@@ -214,12 +238,12 @@ namespace Symple::Binding
 			shared_ptr<Syntax::TypeSyntax> sy = syntax;
 			while (sy = dynamic_pointer_cast<Syntax::TypeReferenceSyntax>(sy) ? dynamic_pointer_cast<Syntax::TypeReferenceSyntax>(sy)->GetBase() : nullptr)
 			{
-				if (!sy->GetName()->Is(Syntax::Token::Asterisk))
+				if (!sy->GetName().Is(Syntax::Token::Asterisk))
 					mDiagnosticBag->ReportUnimplimentedError(sy->GetName());
 				pointerCount++;
 			}
 
-			switch (syntax->GetName()->GetKind())
+			switch (syntax->GetName().GetKind())
 			{
 				TYPE_CONT(Void);
 
@@ -241,15 +265,14 @@ namespace Symple::Binding
 				return Symbol::TypeSymbol::VoidPointerType;
 
 			default:
-				for (auto s : mStructures)
-					if (syntax->GetName()->GetText() == s->GetName())
-						return make_shared<Symbol::TypeSymbol>(s->GetTypeKind(), s->GetName(), s->GetSize(), s->IsFloat(), pointerCount);
+				if (auto s = mStructures->Find(syntax->GetName().GetAtom()))
+					return mContext->GetPointerType(s, pointerCount);
 				return Symbol::TypeSymbol::ErrorType;
 			}
 		}
 		else
 		{
-			switch (syntax->GetName()->GetKind())
+			switch (syntax->GetName().GetKind())
 			{
 				TYPE_CASE(Void);
 
@@ -271,9 +294,8 @@ namespace Symple::Binding
 				return Symbol::TypeSymbol::VoidPointerType;
 
 			default:
-				for (auto s : mStructures)
-					if (syntax->GetName()->GetText() == s->GetName())
-						return s;
+				if (auto s = mStructures->Find(syntax->GetName().GetAtom()))
+					return s;
 				return Symbol::TypeSymbol::ErrorType;
 			}
 		}
@@ -281,15 +303,24 @@ namespace Symple::Binding
 
 	shared_ptr<Symbol::LabelSymbol> Binder::BindLabelSymbol(shared_ptr<Syntax::LabelSyntax> syntax)
 	{
-		shared_ptr<Symbol::LabelSymbol> label = make_shared<Symbol::LabelSymbol>(syntax->GetLabel()->GetText());
-		mLabels.push_back(label);
+		// Labels were declared ahead of the statements, the first one by a name is the one jumped to
+		auto& label = mLabels[syntax->GetLabel().GetAtom()];
+		if (!label)
+			label = make_shared<Symbol::LabelSymbol>(syntax->GetLabel().GetText());
 		return label;
 	}
 
 	shared_ptr<Symbol::FunctionSymbol> Binder::BindFunction(shared_ptr<Syntax::FunctionDeclarationSyntax> syntax)
+	{
+		shared_ptr<Symbol::FunctionSymbol> symbol = BindFunctionSymbol(syntax);
+		mFunctions->push_back({ symbol, BindFunctionBody(symbol, syntax->GetBody()) });
+		return symbol;
+	}
+
+	shared_ptr<Symbol::FunctionSymbol> Binder::BindFunctionSymbol(shared_ptr<Syntax::FunctionDeclarationSyntax> syntax)
 	{
 		shared_ptr<Symbol::TypeSymbol> ty = BindType(syntax->GetType());
-		std::string_view name = syntax->GetName()->GetText();
+		std::string_view name = syntax->GetName().GetText();
 		Symbol::ParameterList params;
 		for (auto param : syntax->GetParameters())
 			params.push_back(BindParameter(param));
@@ -297,7 +328,7 @@ namespace Symple::Binding
 		Symbol::FunctionSymbol::CallingConvention conv = Symbol::FunctionSymbol::CDecl;
 		bool dll = false, isGlobal = true;
 		for (auto mod : syntax->GetModifiers())
-			switch (mod->GetKind())
+			switch (mod.GetKind())
 			{
 			case Syntax::Token::CDeclKeyword:
 				conv = Symbol::FunctionSymbol::CDecl;
@@ -319,24 +350,27 @@ namespace Symple::Binding
 				break;
 			}
 
-		shared_ptr<Symbol::FunctionSymbol> symbol = make_shared<Symbol::FunctionSymbol>(ty, name, params, conv, false, dll, isGlobal);
+		return make_shared<Symbol::FunctionSymbol>(ty, name, params, conv, false, dll, isGlobal);
+	}
+
+	shared_ptr<BoundStatement> Binder::BindFunctionBody(shared_ptr<Symbol::FunctionSymbol> symbol, shared_ptr<Syntax::StatementSyntax> syntax)
+	{
+		mLabels.clear();
+		DeclareLabels(syntax);
 
 		BeginScope();
 		for (auto param : symbol->GetParameters())
-			mScope->DeclareVariable(param);
-		shared_ptr<BoundStatement> body = BindStatement(syntax->GetBody());
+			mScope.DeclareVariable(param);
+		shared_ptr<BoundStatement> body = BindStatement(syntax);
 		EndScope();
 
-		CheckGotoPromises();
-
-		mFunctions.push_back({ symbol, body });
-		return symbol;
+		return body;
 	}
 
 	shared_ptr<Symbol::FunctionSymbol> Binder::BindExternFunction(shared_ptr<Syntax::ExternFunctionSyntax> syntax)
 	{
 		shared_ptr<Symbol::TypeSymbol> ty = BindType(syntax->GetType());
-		std::string_view name = syntax->GetName()->GetText();
+		std::string_view name = syntax->GetName().GetText();
 		Symbol::ParameterList params;
 		for (auto param : syntax->GetParameters())
 			params.push_back(BindParameter(param));
@@ -344,7 +378,7 @@ namespace Symple::Binding
 		Symbol::FunctionSymbol::CallingConvention conv = Symbol::FunctionSymbol::CDecl;
 		bool dll = false, isGlobal = true;
 		for (auto mod : syntax->GetModifiers())
-			switch (mod->GetKind())
+			switch (mod.GetKind())
 			{
 			case Syntax::Token::CDeclKeyword:
 				conv = Symbol::FunctionSymbol::CDecl;
@@ -365,14 +399,14 @@ namespace Symple::Binding
 
 		shared_ptr<Symbol::FunctionSymbol> symbol = make_shared<Symbol::FunctionSymbol>(ty, name, params, conv, dll, false, isGlobal);
 
-		mFunctions.push_back({ symbol, nullptr });
+		mFunctions->push_back({ symbol, nullptr });
 		return symbol;
 	}
 
 	shared_ptr<Symbol::ParameterSymbol> Binder::BindParameter(shared_ptr<Syntax::VariableDeclarationSyntax> syntax)
 	{
 		shared_ptr<Symbol::TypeSymbol> ty = BindType(syntax->GetType());
-		std::string_view name = syntax->GetName()->GetText();
+		std::string_view name = syntax->GetName().GetText();
 		shared_ptr<BoundConstant> init;
 		if (syntax->GetInitializer())
 			init = BindExpression(syntax->GetInitializer())->ConstantValue();
@@ -383,7 +417,7 @@ namespace Symple::Binding
 	shared_ptr<Symbol::MemberSymbol> Binder::BindMember(shared_ptr<Syntax::VariableDeclarationSyntax> syntax)
 	{
 		shared_ptr<Symbol::TypeSymbol> ty = BindType(syntax->GetType());
-		std::string_view name = syntax->GetName()->GetText();
+		std::string_view name = syntax->GetName().GetText();
 		shared_ptr<BoundConstant> init;
 		if (syntax->GetInitializer())
 			init = BindExpression(syntax->GetInitializer())->ConstantValue();
@@ -402,8 +436,8 @@ namespace Symple::Binding
 			members.push_back(memberSymbol);
 		}
 
-		shared_ptr<Symbol::StructTypeSymbol> symbol = make_shared<Symbol::StructTypeSymbol>(syntax->GetName()->GetText(), sz, members);
-		mStructures.push_back(symbol);
+		auto symbol = mContext->InternStruct(syntax->GetName().GetFile(), syntax->GetName().GetAtom(), sz, members);
+		mStructures->push_back(symbol);
 		return symbol;
 	}
 
@@ -421,17 +455,22 @@ namespace Symple::Binding
 		case Syntax::Node::ExternFunction:
 			return BindExternFunction(dynamic_pointer_cast<Syntax::ExternFunctionSyntax>(syntax));
 		case Syntax::Node::FunctionDeclaration:
-			return BindFunction(dynamic_pointer_cast<Syntax::FunctionDeclarationSyntax>(syntax));
+		{
+			auto symbol = BindFunctionSymbol(dynamic_pointer_cast<Syntax::FunctionDeclarationSyntax>(syntax));
+			mFunctions->push_back({ symbol, nullptr });
+			return symbol;
+		}
 		case Syntax::Node::ImportStatement:
 			BindImport(dynamic_pointer_cast<Syntax::ImportStatementSyntax>(syntax));
 			return make_shared<Symbol::Symbol>();
+		default:
+			return nullptr;
 		}
 	}
 
 	shared_ptr<Node> Binder::BindMember(shared_ptr<Syntax::MemberSyntax> syntax)
 	{
 		shared_ptr<Node> result = BindMemberInternal(syntax);
-		mGotoPromises.clear();
 		mLabels.clear();
 		if (!result /* Should not be null, but just in case */)
 		{
@@ -467,7 +506,10 @@ namespace Symple::Binding
 	}
 
 	shared_ptr<BoundStatement> Binder::BindGlobalStatement(shared_ptr<Syntax::GlobalStatementSyntax> syntax)
-	{ return BindStatement(syntax->GetStatement()); }
+	{
+		DeclareLabels(syntax->GetStatement());
+		return BindStatement(syntax->GetStatement());
+	}
 
 	#pragma endregion
 
@@ -528,9 +570,13 @@ namespace Symple::Binding
 
 	shared_ptr<BoundGotoStatement> Binder::BindGotoStatement(shared_ptr<Syntax::GotoStatementSyntax> syntax)
 	{
-		shared_ptr<GotoPromise> promise = make_shared<GotoPromise>(syntax);
-		mGotoPromises.push_back(promise);
-		return make_shared<BoundGotoStatement>(syntax, promise);
+		auto label = mLabels.find(syntax->GetLabel().GetAtom());
+		if (label == mLabels.end())
+		{
+			mDiagnosticBag->ReportUndeclaredLabel(syntax->GetLabel());
+			return make_shared<BoundGotoStatement>(syntax, nullptr);
+		}
+		return make_shared<BoundGotoStatement>(syntax, label->second);
 	}
 
 	shared_ptr<BoundBlockStatement> Binder::BindBlockStatement(shared_ptr<Syntax::BlockStatementSyntax> syntax)
@@ -554,13 +600,13 @@ namespace Symple::Binding
 	shared_ptr<BoundVariableDeclaration> Binder::BindVariableDeclaration(shared_ptr<Syntax::VariableDeclarationSyntax> syntax)
 	{
 		shared_ptr<Symbol::TypeSymbol> ty = BindType(syntax->GetType());
-		std::string_view name = syntax->GetName()->GetText();
+		std::string_view name = syntax->GetName().GetText();
 		shared_ptr<BoundExpression> init;
 		if (syntax->GetInitializer())
 			init = BindExpression(syntax->GetInitializer());
 
 		shared_ptr<Symbol::VariableSymbol> symbol = make_shared<Symbol::VariableSymbol>(ty, name);
-		mScope->DeclareVariable(symbol);
+		mScope.DeclareVariable(symbol);
 		return make_shared<BoundVariableDeclaration>(syntax, symbol, init);
 	}
 
@@ -604,16 +650,51 @@ namespace Symple::Binding
 
 	shared_ptr<BoundExpression> Binder::BindCallExpression(shared_ptr<Syntax::CallExpressionSyntax> syntax)
 	{
-		shared_ptr<FunctionPromise> promise = make_shared<FunctionPromise>(syntax);
-		mFuncPromises.push_back(promise);
-		return make_shared<BoundCallExpression>(syntax, promise);
+		shared_ptr<Symbol::FunctionSymbol> funcSymbol = mFunctions->Find(syntax->GetName().GetAtom());
+		ExpressionList args;
+		if (!funcSymbol)
+		{
+			mDiagnosticBag->ReportNoSuchFunction(syntax);
+			return make_shared<BoundCallExpression>(syntax, nullptr, args);
+		}
+
+		if (syntax->GetArguments().size() > funcSymbol->GetParameters().size())
+			mDiagnosticBag->ReportTooManyArguments(syntax, funcSymbol->GetParameters().size());
+		else
+			for (unsigned i = 0; i < funcSymbol->GetParameters().size(); i++)
+			{
+				shared_ptr<BoundExpression> arg = make_shared<BoundConstantExpression>(funcSymbol->GetParameters()[i]->GetInitializer());
+				if (i < syntax->GetArguments().size())
+				{
+					auto boundArg = BindExpression(syntax->GetArguments()[i]);
+					if (boundArg->GetKind() == Node::DefaultExpression)
+					{
+						if (!arg->ConstantValue())
+						{
+							mDiagnosticBag->ReportNoDefaultArgument(syntax, i);
+							break;
+						}
+					}
+					else
+						arg = boundArg;
+				}
+				else if (!arg->ConstantValue())
+				{
+					mDiagnosticBag->ReportTooFewArguments(syntax);
+					break;
+				}
+
+				args.push_back(arg);
+			}
+
+		return make_shared<BoundCallExpression>(syntax, funcSymbol, args);
 	}
 
 	shared_ptr<BoundUnaryExpression> Binder::BindUnaryExpression(shared_ptr<Syntax::UnaryExpressionSyntax> syntax)
 	{
 		shared_ptr<BoundExpression> operand = BindExpression(syntax->GetOperand());
 
-		shared_ptr<BoundUnaryOperator> op = BoundUnaryOperator::Bind(syntax->GetOperator()->GetKind(), operand->GetType());
+		shared_ptr<BoundUnaryOperator> op = BoundUnaryOperator::Bind(syntax->GetOperator().GetKind(), operand->GetType());
 		if (op == BoundUnaryOperator::ErrorOperator)
 			mDiagnosticBag->ReportInvalidOperation(syntax->GetOperator(), operand->GetType());
 
@@ -624,16 +705,19 @@ namespace Symple::Binding
 	{
 		shared_ptr<BoundExpression> left = BindExpression(syntax->GetLeft());
 
-		if (syntax->GetOperator()->Is(Syntax::Token::Period))
+		if (syntax->GetOperator().Is(Syntax::Token::Period))
 		{
-			shared_ptr<MemberPromise> promise = make_shared<MemberPromise>(std::pair(left, syntax));
-			mMemPromises.push_back(promise);
-			return make_shared<BoundFieldExpression>(syntax, promise);
+			shared_ptr<Symbol::MemberSymbol> member;
+			if (auto ztruct = dynamic_pointer_cast<Symbol::StructTypeSymbol>(left->GetType()))
+				member = ztruct->FindMember(syntax->GetRight()->GetToken().GetAtom());
+			if (!member)
+				mDiagnosticBag->ReportBindError(syntax);
+			return make_shared<BoundFieldExpression>(syntax, left, member);
 		}
 
 		shared_ptr<BoundExpression> right = BindExpression(syntax->GetRight());
 
-		shared_ptr<BoundBinaryOperator> op = BoundBinaryOperator::Bind(syntax->GetOperator()->GetKind(), left->GetType(), right->GetType());
+		shared_ptr<BoundBinaryOperator> op = BoundBinaryOperator::Bind(syntax->GetOperator().GetKind(), left->GetType(), right->GetType());
 		if (op == BoundBinaryOperator::ErrorOperator)
 		{
 			mDiagnosticBag->ReportInvalidOperation(syntax->GetOperator(), left->GetType(), right->GetType());
@@ -652,16 +736,16 @@ namespace Symple::Binding
 	{
 		shared_ptr<Symbol::TypeSymbol> ty;
 		shared_ptr<BoundConstant> constant;
-		switch (syntax->GetLiteral()->GetKind())
+		switch (syntax->GetLiteral().GetKind())
 		{
 		case Syntax::Token::Integer:
 		{
-			if (std::stoll(std::string(syntax->GetLiteral()->GetText())) & 0xFFFFFFFF00000000)
+			if (std::stoll(std::string(syntax->GetLiteral().GetText())) & 0xFFFFFFFF00000000)
 				ty = Symbol::TypeSymbol::LongType;
 			else
 				ty = Symbol::TypeSymbol::IntType;
 
-			long long val = std::stoll(std::string(syntax->GetLiteral()->GetText()));
+			long long val = std::stoll(std::string(syntax->GetLiteral().GetText()));
 			constant = make_shared<BoundConstant>(BoundConstant::Integer, &val);
 			break;
 		}
@@ -669,7 +753,7 @@ namespace Symple::Binding
 		{
 			ty = Symbol::TypeSymbol::DoubleType;
 
-			double val = std::stod(std::string(syntax->GetLiteral()->GetText()));
+			double val = std::stod(std::string(syntax->GetLiteral().GetText()));
 			constant = make_shared<BoundConstant>(BoundConstant::Float, &val);
 			break;
 		}
@@ -677,7 +761,7 @@ namespace Symple::Binding
 		{
 			ty = Symbol::TypeSymbol::FloatType;
 
-			float val = std::stof(std::string(syntax->GetLiteral()->GetText()));
+			float val = std::stof(std::string(syntax->GetLiteral().GetText()));
 			constant = make_shared<BoundConstant>(BoundConstant::Float, &val);
 			break;
 		}
@@ -700,12 +784,12 @@ namespace Symple::Binding
 
 	shared_ptr<BoundExpression> Binder::BindNameExpression(shared_ptr<Syntax::NameExpressionSyntax> syntax)
 	{
-		shared_ptr<Symbol::VariableSymbol> varSymbol = mScope->GetVariableSymbol(syntax->GetToken()->GetText());
+		shared_ptr<Symbol::VariableSymbol> varSymbol = mScope.GetVariableSymbol(syntax->GetToken().GetAtom());
 		if (varSymbol)
 			return make_shared<BoundVariableExpression>(syntax, varSymbol);
 		else
 		{
-			shared_ptr<Symbol::FunctionSymbol> fnSymbol = FindFunction(mFunctions, syntax->GetToken()->GetText());
+			shared_ptr<Symbol::FunctionSymbol> fnSymbol = mFunctions->Find(syntax->GetToken().GetAtom());
 
 			if (fnSymbol)
 				return make_shared<BoundFunctionPointer>(syntax, fnSymbol);
@@ -722,4 +806,15 @@ namespace Symple::Binding
 
 	shared_ptr<DiagnosticBag> Binder::GetDiagnosticBag()
 	{ return mDiagnosticBag; }
+
+	std::vector<SymbolCache::Import>& Binder::GetImports()
+	{ return mImports; }
+
+	std::string Binder::GetImportPath(shared_ptr<Syntax::ImportStatementSyntax> syntax)
+	{
+		std::string path = syntax->GetImport().GetFile();
+		path = path.substr(0, path.find_last_of('/') + 1);
+		path += syntax->GetImport().GetText();
+		return path;
+	}
 }
\ No newline at end of file
@@ -1,91 +1,129 @@
 #include "SympleCode/Binding/BoundBinaryOperator.h"
 
-#include "SympleCode/Binding/Casting.h"
+#include <iterator>
 
 namespace Symple::Binding
 {
 	// Explicit Declaration instead of using 'make_shared' because this is a private constructor
-	std::vector<shared_ptr<BoundBinaryOperator>> BoundBinaryOperator::sOperators;
 	shared_ptr<BoundBinaryOperator> BoundBinaryOperator::ErrorOperator = shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Unknown, Unknown, Symbol::TypeSymbol::ErrorType, Symbol::TypeSymbol::ErrorType, Symbol::TypeSymbol::ErrorType));;
 
-	BoundBinaryOperator::BoundBinaryOperator(Syntax::Token::Kind tokenKind, Kind kind, shared_ptr<Symbol::TypeSymbol> leftType, shared_ptr<Symbol::TypeSymbol> rightType, shared_ptr<Symbol::TypeSymbol> type, bool mut)
-		: mTokenKind(tokenKind), mKind(kind), mLeftType(leftType), mRightType(rightType), mType(type), mMutable(mut)
-	{}
+	struct BinaryOperatorDescriptor
+	{
+		Syntax::Token::Kind TokenKind;
+		BoundBinaryOperator::Kind Operator;
+		Symbol::TypeSymbol::TypeKind LeftType, RightType, Type;
+		bool Mutable = false;
+	};
 
+#define BINARY_OPERATOR(tok, op, ty, ...) { Syntax::Token::##tok, BoundBinaryOperator::##op, Symbol::TypeSymbol::##ty, Symbol::TypeSymbol::##ty, Symbol::TypeSymbol::##ty, ##__VA_ARGS__ }
 
-	void BoundBinaryOperator::Print(std::ostream& os, std::string_view indent, bool last, std::string_view label)
-	{
-		Syntax::Node::PrintIndent(os, indent, last, label);
-		os << "BoundBinary" << KindMap[GetKind()] << " (" << Syntax::Token::KindMap[GetTokenKind()] << ')';
-	}
+	static constexpr BinaryOperatorDescriptor sDescriptors[] = {
+		BINARY_OPERATOR(Plus, Addition, Int),
+		BINARY_OPERATOR(Plus, Addition, Long),
 
-	void BoundBinaryOperator::PrintShort(std::ostream& os)
-	{ os << '(' << KindMap[GetKind()] << ')'; }
+		BINARY_OPERATOR(Plus, Addition, Float),
+		BINARY_OPERATOR(Plus, Addition, Double),
+		BINARY_OPERATOR(Plus, Addition, Triple),
 
 
-	shared_ptr<BoundBinaryOperator> BoundBinaryOperator::Bind(Syntax::Token::Kind tokenKind, shared_ptr<Symbol::TypeSymbol> leftType, shared_ptr<Symbol::TypeSymbol> rightType)
-	{
-		if (sOperators.empty())
-			sOperators = {
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Plus, Addition, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Plus, Addition, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
+		BINARY_OPERATOR(Dash, Subtraction, Int),
+		BINARY_OPERATOR(Dash, Subtraction, Long),
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Plus, Addition, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Plus, Addition, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Plus, Addition, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
+		BINARY_OPERATOR(Dash, Subtraction, Float),
+		BINARY_OPERATOR(Dash, Subtraction, Double),
+		BINARY_OPERATOR(Dash, Subtraction, Triple),
 
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Dash, Subtraction, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Dash, Subtraction, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
+		BINARY_OPERATOR(Asterisk, Multiplication, Int),
+		BINARY_OPERATOR(Asterisk, Multiplication, Long),
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Dash, Subtraction, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Dash, Subtraction, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Dash, Subtraction, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
+		BINARY_OPERATOR(Asterisk, Multiplication, Float),
+		BINARY_OPERATOR(Asterisk, Multiplication, Double),
+		BINARY_OPERATOR(Asterisk, Multiplication, Triple),
 
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Asterisk, Multiplication, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Asterisk, Multiplication, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
+		BINARY_OPERATOR(Slash, Division, Int),
+		BINARY_OPERATOR(Slash, Division, Long),
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Asterisk, Multiplication, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Asterisk, Multiplication, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Asterisk, Multiplication, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
+		BINARY_OPERATOR(Slash, Division, Float),
+		BINARY_OPERATOR(Slash, Division, Double),
+		BINARY_OPERATOR(Slash, Division, Triple),
 
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Slash, Division, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Slash, Division, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
+		BINARY_OPERATOR(Percentage, Modulo, Int),
+		BINARY_OPERATOR(Percentage, Modulo, Long),
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Slash, Division, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Slash, Division, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Slash, Division, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
+		BINARY_OPERATOR(Percentage, Modulo, Float),
+		BINARY_OPERATOR(Percentage, Modulo, Double),
+		BINARY_OPERATOR(Percentage, Modulo, Triple),
 
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Percentage, Modulo, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Percentage, Modulo, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
+		BINARY_OPERATOR(Equal, Assign, Byte, true),
+		BINARY_OPERATOR(Equal, Assign, Short, true),
+		BINARY_OPERATOR(Equal, Assign, Int, true),
+		BINARY_OPERATOR(Equal, Assign, Long, true),
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Percentage, Modulo, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Percentage, Modulo, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Percentage, Modulo, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
+		BINARY_OPERATOR(Equal, Assign, Float, true),
+		BINARY_OPERATOR(Equal, Assign, Double, true),
+		BINARY_OPERATOR(Equal, Assign, Triple, true),
+	};
 
+#undef BINARY_OPERATOR
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::ByteType, Symbol::TypeSymbol::ByteType, Symbol::TypeSymbol::ByteType, true)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::ShortType, Symbol::TypeSymbol::ShortType, Symbol::TypeSymbol::ShortType, true)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType, true)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType, true)),
+	static_assert(std::size(sDescriptors) < 0xFF, "Binary operators no longer fit in the table");
 
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType, true)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType, true)),
-				shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(Syntax::Token::Equal, Assign, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType, true)),
-			};
+	// One past the descriptor for every token and pair of operand kinds, 0 where there's no operator
+	struct BinaryOperatorTable
+	{
+		unsigned char Index[Syntax::Token::Last + 1][Symbol::TypeSymbol::Last + 1][Symbol::TypeSymbol::Last + 1] = {};
 
-		for (auto op : sOperators)
+		constexpr BinaryOperatorTable()
 		{
-			bool exactSame = op->GetLeftType()->Equals(leftType) && op->GetRightType()->Equals(rightType);
-			bool canCast = CastTable::CanImplicitelyCast(op->GetLeftType(), leftType) && CastTable::CanImplicitelyCast(op->GetRightType(), rightType);
-			if (op->GetTokenKind() == tokenKind && exactSame)
-				return op;
+			// Backwards so the first of two matching descriptors wins
+			for (unsigned i = std::size(sDescriptors); i; i--)
+				Index[sDescriptors[i - 1].TokenKind][sDescriptors[i - 1].LeftType][sDescriptors[i - 1].RightType] = i;
 		}
+	};
+
+	static constexpr BinaryOperatorTable sTable;
+
+	BoundBinaryOperator::BoundBinaryOperator(Syntax::Token::Kind tokenKind, Kind kind, shared_ptr<Symbol::TypeSymbol> leftType, shared_ptr<Symbol::TypeSymbol> rightType, shared_ptr<Symbol::TypeSymbol> type, bool mut)
+		: mTokenKind(tokenKind), mKind(kind), mLeftType(leftType), mRightType(rightType), mType(type), mMutable(mut)
+	{}
+
+
+	void BoundBinaryOperator::Print(std::ostream& os, std::string_view indent, bool last, std::string_view label)
+	{
+		Syntax::Node::PrintIndent(os, indent, last, label);
+		os << "BoundBinary" << KindMap[GetKind()] << " (" << Syntax::Token::KindMap[GetTokenKind()] << ')';
+	}
+
+	void BoundBinaryOperator::PrintShort(std::ostream& os)
+	{ os << '(' << KindMap[GetKind()] << ')'; }
+
+
+	std::vector<shared_ptr<BoundBinaryOperator>>& BoundBinaryOperator::GetOperators()
+	{
+		static std::vector<shared_ptr<BoundBinaryOperator>> sOperators = []()
+		{
+			std::vector<shared_ptr<BoundBinaryOperator>> operators;
+			for (auto& op : sDescriptors)
+				operators.push_back(shared_ptr<BoundBinaryOperator>(new BoundBinaryOperator(op.TokenKind, op.Operator,
+					Symbol::TypeSymbol::GetBuiltinType(op.LeftType), Symbol::TypeSymbol::GetBuiltinType(op.RightType), Symbol::TypeSymbol::GetBuiltinType(op.Type), op.Mutable)));
+			return operators;
+		}();
+
+		return sOperators;
+	}
+
+	shared_ptr<BoundBinaryOperator> BoundBinaryOperator::Bind(Syntax::Token::Kind tokenKind, shared_ptr<Symbol::TypeSymbol> leftType, shared_ptr<Symbol::TypeSymbol> rightType)
+	{
+		// None of the operators take pointers
+		if (tokenKind > Syntax::Token::Last || leftType->GetPointerCount() || rightType->GetPointerCount())
+			return ErrorOperator;
 
-		return ErrorOperator;
+		unsigned char index = sTable.Index[tokenKind][leftType->GetTypeKind()][rightType->GetTypeKind()];
+		return index ? GetOperators()[index - 1] : ErrorOperator;
 	}
 
 
@@ -1,11 +1,65 @@
 #include "SympleCode/Binding/BoundUnaryOperator.h"
 
+#include <iterator>
+
 namespace Symple::Binding
 {
 	// Explicit Declaration instead of using 'make_shared' because this is a private constructor
-	std::vector<shared_ptr<BoundUnaryOperator>> BoundUnaryOperator::sOperators;
 	shared_ptr<BoundUnaryOperator> BoundUnaryOperator::ErrorOperator = shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Unknown, Negative, Symbol::TypeSymbol::ErrorType, Symbol::TypeSymbol::ErrorType));;
 
+	struct UnaryOperatorDescriptor
+	{
+		Syntax::Token::Kind TokenKind;
+		BoundUnaryOperator::Kind Operator;
+		Symbol::TypeSymbol::TypeKind OperandType, Type;
+	};
+
+#define UNARY_OPERATOR(tok, op, operandTy, ty) { Syntax::Token::##tok, BoundUnaryOperator::##op, Symbol::TypeSymbol::##operandTy, Symbol::TypeSymbol::##ty }
+
+	static constexpr UnaryOperatorDescriptor sDescriptors[] = {
+		UNARY_OPERATOR(Plus, Positive, Int, Int),
+		UNARY_OPERATOR(Plus, Positive, Long, Long),
+
+		UNARY_OPERATOR(Plus, Positive, Float, Float),
+		UNARY_OPERATOR(Plus, Positive, Double, Double),
+		UNARY_OPERATOR(Plus, Positive, Triple, Triple),
+
+
+		UNARY_OPERATOR(Dash, Negative, Int, Int),
+		UNARY_OPERATOR(Dash, Negative, Long, Long),
+
+		UNARY_OPERATOR(Dash, Negative, Float, Float),
+		UNARY_OPERATOR(Dash, Negative, Double, Double),
+		UNARY_OPERATOR(Dash, Negative, Triple, Triple),
+
+
+		UNARY_OPERATOR(Exclamation, Not, Int, Bool),
+		UNARY_OPERATOR(Exclamation, Not, Long, Bool),
+
+		UNARY_OPERATOR(Exclamation, Not, Float, Bool),
+		UNARY_OPERATOR(Exclamation, Not, Double, Bool),
+		UNARY_OPERATOR(Exclamation, Not, Triple, Bool),
+	};
+
+#undef UNARY_OPERATOR
+
+	static_assert(std::size(sDescriptors) < 0xFF, "Unary operators no longer fit in the table");
+
+	// One past the descriptor for every token and operand kind, 0 where there's no operator
+	struct UnaryOperatorTable
+	{
+		unsigned char Index[Syntax::Token::Last + 1][Symbol::TypeSymbol::Last + 1] = {};
+
+		constexpr UnaryOperatorTable()
+		{
+			// Backwards so the first of two matching descriptors wins
+			for (unsigned i = std::size(sDescriptors); i; i--)
+				Index[sDescriptors[i - 1].TokenKind][sDescriptors[i - 1].OperandType] = i;
+		}
+	};
+
+	static constexpr UnaryOperatorTable sTable;
+
 	BoundUnaryOperator::BoundUnaryOperator(Syntax::Token::Kind tokenKind, Kind kind, shared_ptr<Symbol::TypeSymbol> operandType, shared_ptr<Symbol::TypeSymbol> type)
 		: mTokenKind(tokenKind), mKind(kind), mOperandType(operandType), mType(type)
 	{}
@@ -23,39 +77,28 @@ namespace Symple::Binding
 	}
 
 
-	shared_ptr<BoundUnaryOperator> BoundUnaryOperator::Bind(Syntax::Token::Kind tokenKind, shared_ptr<Symbol::TypeSymbol> operandType)
+	std::vector<shared_ptr<BoundUnaryOperator>>& BoundUnaryOperator::GetOperators()
 	{
-		if (sOperators.empty())
-			sOperators = {
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Plus, Positive, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Plus, Positive, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
-
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Plus, Positive, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Plus, Positive, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Plus, Positive, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
-
-
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Dash, Negative, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::IntType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Dash, Negative, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::LongType)),
-
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Dash, Negative, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::FloatType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Dash, Negative, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::DoubleType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Dash, Negative, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::TripleType)),
-
-
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Exclamation, Not, Symbol::TypeSymbol::IntType, Symbol::TypeSymbol::BoolType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Exclamation, Not, Symbol::TypeSymbol::LongType, Symbol::TypeSymbol::BoolType)),
-				
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Exclamation, Not, Symbol::TypeSymbol::FloatType, Symbol::TypeSymbol::BoolType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Exclamation, Not, Symbol::TypeSymbol::DoubleType, Symbol::TypeSymbol::BoolType)),
-				shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(Syntax::Token::Exclamation, Not, Symbol::TypeSymbol::TripleType, Symbol::TypeSymbol::BoolType)),
-			};
+		static std::vector<shared_ptr<BoundUnaryOperator>> sOperators = []()
+		{
+			std::vector<shared_ptr<BoundUnaryOperator>> operators;
+			for (auto& op : sDescriptors)
+				operators.push_back(shared_ptr<BoundUnaryOperator>(new BoundUnaryOperator(op.TokenKind, op.Operator,
+					Symbol::TypeSymbol::GetBuiltinType(op.OperandType), Symbol::TypeSymbol::GetBuiltinType(op.Type))));
+			return operators;
+		}();
+
+		return sOperators;
+	}
 
-		for (auto op : sOperators)
-			if (op->GetTokenKind() == tokenKind && op->GetOperandType()->Equals(operandType))
-				return op;
+	shared_ptr<BoundUnaryOperator> BoundUnaryOperator::Bind(Syntax::Token::Kind tokenKind, shared_ptr<Symbol::TypeSymbol> operandType)
+	{
+		// None of the operators take pointers
+		if (tokenKind > Syntax::Token::Last || operandType->GetPointerCount())
+			return ErrorOperator;
 
-		return ErrorOperator;
+		unsigned char index = sTable.Index[tokenKind][operandType->GetTypeKind()];
+		return index ? GetOperators()[index - 1] : ErrorOperator;
 	}
 
 
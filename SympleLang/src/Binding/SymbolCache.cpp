@@ -0,0 +1,376 @@
+#include "SympleCode/Binding/SymbolCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "SympleCode/Binding/Binder.h"
+#include "SympleCode/Syntax/TreeCache.h"
+#include "SympleCode/Util/FileUtil.h"
+
+#include "SympleCode/Compiler.h"
+
+namespace Symple::Binding
+{
+	// Magic, version, key and the hash of everything after the header
+	static constexpr unsigned sHeaderSize = 4 + sizeof(unsigned) + sizeof(uint64_t) * 2;
+
+	shared_ptr<BoundCompilationUnit> SymbolCache::Load(char* path, char* file, shared_ptr<CompilationContext> context)
+	{
+		SymbolCache cache;
+		uint64_t key;
+		if (!cache.ReadFile(path, key))
+			return nullptr;
+
+		std::vector<Import> imports;
+		cache.ReadImports(imports);
+		if (cache.mFailed)
+			return nullptr;
+
+		// Registers them for linking too, like binding the file would have
+		Binder binder(context);
+		for (auto& import : imports)
+			binder.BindImport(import.Path, import.Name);
+		if (GetKey(file, imports, context) != key)
+			return nullptr;
+
+		struct StructEntry
+		{
+			std::string Name;
+			unsigned Size;
+			std::vector<VariableEntry> Members;
+		};
+
+		std::vector<StructEntry> structEntries;
+		unsigned structCount = cache.Read<unsigned>();
+		for (unsigned i = 0; i < structCount && !cache.mFailed; i++)
+		{
+			StructEntry entry;
+			entry.Name = cache.ReadString();
+			entry.Size = cache.Read<unsigned>();
+			unsigned memberCount = cache.Read<unsigned>();
+			for (unsigned j = 0; j < memberCount && !cache.mFailed; j++)
+				entry.Members.push_back(cache.ReadVariable());
+			structEntries.push_back(std::move(entry));
+			cache.mStructureCount++;
+		}
+
+		struct FunctionEntry
+		{
+			TypeEntry Type;
+			std::string Name;
+			std::vector<VariableEntry> Parameters;
+			unsigned char Convention, Flags;
+		};
+
+		std::vector<FunctionEntry> funcEntries;
+		unsigned funcCount = cache.Read<unsigned>();
+		for (unsigned i = 0; i < funcCount && !cache.mFailed; i++)
+		{
+			FunctionEntry entry;
+			entry.Type = cache.ReadType();
+			entry.Name = cache.ReadString();
+			unsigned paramCount = cache.Read<unsigned>();
+			for (unsigned j = 0; j < paramCount && !cache.mFailed; j++)
+				entry.Parameters.push_back(cache.ReadVariable());
+			entry.Convention = cache.Read<unsigned char>();
+			entry.Flags = cache.Read<unsigned char>();
+			funcEntries.push_back(std::move(entry));
+		}
+
+		if (cache.mFailed || cache.mPosition != cache.mData.length())
+			return nullptr;
+
+		std::vector<shared_ptr<Symbol::StructTypeSymbol>> structSymbols;
+		StructMap structs;
+		for (auto& entry : structEntries)
+		{
+			Symbol::MemberList members;
+			for (auto& member : entry.Members)
+				members.push_back(make_shared<Symbol::MemberSymbol>(MakeType(member.Type, structSymbols, context), Util::Atom(member.Name), member.Initializer));
+
+			auto symbol = context->InternStruct(file, Util::Atom(entry.Name), entry.Size, members);
+			structSymbols.push_back(symbol);
+			structs.push_back(symbol);
+		}
+
+		FunctionMap funcs;
+		for (auto& entry : funcEntries)
+		{
+			Symbol::ParameterList params;
+			for (auto& param : entry.Parameters)
+				params.push_back(make_shared<Symbol::ParameterSymbol>(MakeType(param.Type, structSymbols, context), Util::Atom(param.Name), param.Initializer));
+
+			auto conv = (Symbol::FunctionSymbol::CallingConvention)entry.Convention;
+			funcs.push_back({ make_shared<Symbol::FunctionSymbol>(MakeType(entry.Type, structSymbols, context), Util::Atom(entry.Name), params, conv,
+				entry.Flags & 1, entry.Flags & 2, entry.Flags & 4), nullptr });
+		}
+
+		context->SetKey(file, key);
+		return make_shared<BoundCompilationUnit>(nullptr, std::move(structs), std::move(funcs));
+	}
+
+	bool SymbolCache::Store(char* path, char* file, shared_ptr<BoundCompilationUnit> unit, std::vector<Import>& imports, shared_ptr<CompilationContext> context)
+	{
+		uint64_t key = GetKey(file, imports, context);
+		if (!key)
+			return false;
+
+		SymbolCache cache;
+		cache.Write<unsigned>(imports.size());
+		for (auto& import : imports)
+		{
+			cache.Write(std::string_view(import.Path));
+			cache.Write(std::string_view(import.Name));
+		}
+
+		unsigned structCount = 0;
+		for (auto s : unit->GetStructures())
+			structCount++;
+		cache.Write<unsigned>(structCount);
+		for (auto s : unit->GetStructures())
+		{
+			cache.Write(s->GetName());
+			cache.Write<unsigned>(s->GetSize());
+			cache.Write<unsigned>(s->GetMembers().size());
+			for (auto member : s->GetMembers())
+			{
+				cache.Write(member->GetType());
+				cache.Write(member->GetName());
+				cache.Write(member->GetInitializer());
+			}
+			cache.mStructures.push_back(s);
+		}
+
+		cache.Write<unsigned>(unit->GetFunctions().size());
+		for (auto& [fn, body] : unit->GetFunctions())
+		{
+			cache.Write(fn->GetType());
+			cache.Write(fn->GetName());
+			cache.Write<unsigned>(fn->GetParameters().size());
+			for (auto param : fn->GetParameters())
+			{
+				cache.Write(param->GetType());
+				cache.Write(param->GetName());
+				cache.Write(param->GetInitializer());
+			}
+			cache.Write<unsigned char>(fn->GetCallingConvention());
+			cache.Write<unsigned char>(fn->IsDllImport() | fn->IsDllExport() << 1 | fn->IsGlobal() << 2);
+		}
+		if (cache.mFailed)
+			return false;
+
+		std::string header(sMagic, sizeof(sMagic));
+		header.append((char*)&sVersion, sizeof(sVersion));
+		header.append((char*)&key, sizeof(key));
+		uint64_t hash = Syntax::TreeCache::Hash(cache.mData);
+		header.append((char*)&hash, sizeof(hash));
+
+		// Written next to it and moved into place, anything reading it meanwhile finds either the old entry or none
+		std::string temporary = std::string(path) + ".tmp";
+		FILE* fs = Util::OpenFile(temporary.data(), "wb");
+		if (!fs)
+			return false;
+		bool written = fwrite(header.data(), 1, header.length(), fs) == header.length() &&
+			fwrite(cache.mData.data(), 1, cache.mData.length(), fs) == cache.mData.length();
+		Util::CloseFile(fs);
+
+		std::remove(path);
+		if (!written || std::rename(temporary.c_str(), path))
+		{
+			std::remove(temporary.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	bool SymbolCache::LoadImports(char* path, std::vector<Import>& imports)
+	{
+		SymbolCache cache;
+		uint64_t key;
+		if (!cache.ReadFile(path, key))
+			return false;
+
+		cache.ReadImports(imports);
+		return !cache.mFailed;
+	}
+
+	uint64_t SymbolCache::GetKey(char* file, std::vector<Import>& imports, shared_ptr<CompilationContext> context)
+	{
+		Util::MappedFile source(file);
+		uint64_t hash = Syntax::TreeCache::Hash(source.GetText());
+		std::string keys((char*)&hash, sizeof(hash));
+		for (auto& import : imports)
+		{
+			// Libraries don't have one
+			if (_access(import.Path.c_str(), 0) == -1)
+				continue;
+
+			uint64_t key = context->GetKey(import.Path);
+			if (!key)
+				return 0;
+			keys.append((char*)&key, sizeof(key));
+		}
+		return Syntax::TreeCache::Hash(keys);
+	}
+
+	bool SymbolCache::ReadFile(char* path, uint64_t& key)
+	{
+		FILE* fs;
+		if (fopen_s(&fs, path, "rb") || !fs)
+			return false;
+
+		// Not Util::ReadFile, that stops at the first null
+		fseek(fs, 0, SEEK_END);
+		long size = ftell(fs);
+		if (size < 0)
+		{
+			Util::CloseFile(fs);
+			return false;
+		}
+		mData.resize(size);
+		rewind(fs);
+		mData.resize(fread(mData.data(), 1, mData.length(), fs));
+		Util::CloseFile(fs);
+
+		if (mData.length() < sHeaderSize || memcmp(mData.data(), sMagic, sizeof(sMagic)))
+			return false;
+		mPosition = sizeof(sMagic);
+		if (Read<unsigned>() != sVersion)
+			return false;
+		key = Read<uint64_t>();
+		return Read<uint64_t>() == Syntax::TreeCache::Hash(std::string_view(mData).substr(sHeaderSize));
+	}
+
+
+	template<typename T>
+	void SymbolCache::Write(T value)
+	{ mData.append((char*)&value, sizeof(T)); }
+
+	void SymbolCache::Write(std::string_view text)
+	{
+		Write<unsigned>(text.length());
+		mData.append(text);
+	}
+
+	void SymbolCache::Write(shared_ptr<Symbol::TypeSymbol> type)
+	{
+		// The binder never gives types modifiers, so there's nothing to keep them apart by
+		if (!type->GetModifiers().empty())
+			mFailed = true;
+
+		Write<unsigned char>(type->GetTypeKind());
+		if (type->Is(Symbol::TypeSymbol::Struct))
+		{
+			// Structures can only refer to the ones declared before them
+			unsigned i = 0;
+			while (i < mStructures.size() && mStructures[i]->GetAtom() != type->GetAtom())
+				i++;
+			if (i == mStructures.size())
+				mFailed = true;
+			Write<unsigned>(i);
+		}
+		Write<unsigned>(type->GetPointerCount());
+	}
+
+	void SymbolCache::Write(shared_ptr<BoundConstant> constant)
+	{
+		Write<bool>(constant != nullptr);
+		if (constant)
+		{
+			Write<unsigned char>(constant->GetKind());
+			mData.append(&constant->GetValue<char>(), 16);
+		}
+	}
+
+
+	template<typename T>
+	T SymbolCache::Read()
+	{
+		T value = {};
+		if (mPosition + sizeof(T) > mData.length())
+			mFailed = true;
+		else
+		{
+			memcpy(&value, mData.data() + mPosition, sizeof(T));
+			mPosition += sizeof(T);
+		}
+		return value;
+	}
+
+	std::string SymbolCache::ReadString()
+	{
+		unsigned length = Read<unsigned>();
+		if (mFailed || length > mData.length() - mPosition)
+		{
+			mFailed = true;
+			return {};
+		}
+
+		mPosition += length;
+		return mData.substr(mPosition - length, length);
+	}
+
+	SymbolCache::TypeEntry SymbolCache::ReadType()
+	{
+		TypeEntry type = {};
+		type.Kind = (Symbol::TypeSymbol::TypeKind)Read<unsigned char>();
+		if (type.Kind == Symbol::TypeSymbol::Struct)
+		{
+			type.Structure = Read<unsigned>();
+			if (type.Structure >= mStructureCount)
+				mFailed = true;
+		}
+		type.PointerCount = Read<unsigned>();
+		return type;
+	}
+
+	SymbolCache::VariableEntry SymbolCache::ReadVariable()
+	{
+		VariableEntry var;
+		var.Type = ReadType();
+		var.Name = ReadString();
+		var.Initializer = ReadConstant();
+		return var;
+	}
+
+	void SymbolCache::ReadImports(std::vector<Import>& imports)
+	{
+		unsigned count = Read<unsigned>();
+		for (unsigned i = 0; i < count && !mFailed; i++)
+		{
+			std::string path = ReadString();
+			imports.push_back({ path, ReadString() });
+		}
+	}
+
+	shared_ptr<BoundConstant> SymbolCache::ReadConstant()
+	{
+		if (!Read<bool>())
+			return nullptr;
+
+		auto kind = (BoundConstant::Kind)Read<unsigned char>();
+		char value[16] = {};
+		if (mPosition + sizeof(value) > mData.length())
+		{
+			mFailed = true;
+			return nullptr;
+		}
+		memcpy(value, mData.data() + mPosition, sizeof(value));
+		mPosition += sizeof(value);
+		return make_shared<BoundConstant>(kind, value);
+	}
+
+
+	shared_ptr<Symbol::TypeSymbol> SymbolCache::MakeType(TypeEntry& type, std::vector<shared_ptr<Symbol::StructTypeSymbol>>& structs, shared_ptr<CompilationContext> context)
+	{
+		shared_ptr<Symbol::TypeSymbol> base;
+		if (type.Kind == Symbol::TypeSymbol::Struct)
+			base = structs[type.Structure];
+		else
+			base = Symbol::TypeSymbol::GetBuiltinType(type.Kind);
+
+		if (!type.PointerCount || base == Symbol::TypeSymbol::ErrorType)
+			return base;
+		return context->GetPointerType(base, type.PointerCount);
+	}
+}
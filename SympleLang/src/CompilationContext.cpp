@@ -0,0 +1,126 @@
+#include "SympleCode/CompilationContext.h"
+
+#include "SympleCode/Util/ThreadPool.h"
+
+namespace Symple
+{
+	CompilationContext::CompilationContext()
+	{
+		// So the builtin pointer types are the ones made here
+		for (auto type : { Symbol::TypeSymbol::VoidPointerType, Symbol::TypeSymbol::BytePointerType, Symbol::TypeSymbol::CharPointerType })
+			mPointers[{ type->GetBase().get(), type->GetPointerCount() }] = type;
+	}
+
+	shared_ptr<Binding::BoundCompilationUnit> CompilationContext::GetImport(const std::string& path)
+	{
+		std::lock_guard lock(mMutex);
+		auto imported = mImportedSymbols.find(path);
+		return imported == mImportedSymbols.end() ? nullptr : imported->second;
+	}
+
+	void CompilationContext::AddImport(const std::string& path, shared_ptr<Binding::BoundCompilationUnit> unit)
+	{
+		std::lock_guard lock(mMutex);
+		mImportedSymbols.insert({ path, unit });
+	}
+
+	uint64_t CompilationContext::GetKey(const std::string& path)
+	{
+		std::lock_guard lock(mMutex);
+		auto key = mKeys.find(path);
+		return key == mKeys.end() ? 0 : key->second;
+	}
+
+	void CompilationContext::SetKey(const std::string& path, uint64_t key)
+	{
+		std::lock_guard lock(mMutex);
+		mKeys[path] = key;
+	}
+
+	shared_ptr<Symbol::StructTypeSymbol> CompilationContext::InternStruct(Util::Atom file, Util::Atom name, unsigned sz, Symbol::MemberList members)
+	{
+		std::lock_guard lock(mMutex);
+		shared_ptr<Symbol::StructTypeSymbol>& type = mStructs[{ file, name }];
+		if (!type || !type->Matches(sz, members))
+			type = make_shared<Symbol::StructTypeSymbol>(name, sz, members);
+		return type;
+	}
+
+	shared_ptr<Symbol::TypeSymbol> CompilationContext::GetPointerType(shared_ptr<Symbol::TypeSymbol> base, unsigned pointerCount)
+	{
+		if (base->GetBase())
+			base = base->GetBase();
+		if (!pointerCount)
+			return base;
+
+		std::lock_guard lock(mMutex);
+		std::weak_ptr<Symbol::TypeSymbol>& entry = mPointers[{ base.get(), pointerCount }];
+		shared_ptr<Symbol::TypeSymbol> type = entry.lock();
+		if (!type)
+			entry = type = Symbol::TypeSymbol::MakePointerType(base, pointerCount);
+
+		// Drops the entries of types nobody uses anymore, like those of structs that were declared again
+		if (mPointers.size() >= mPruneSize)
+		{
+			for (auto it = mPointers.begin(); it != mPointers.end();)
+				if (it->second.expired())
+					it = mPointers.erase(it);
+				else
+					++it;
+			mPruneSize = mPointers.size() * 2 + 64;
+		}
+		return type;
+	}
+
+	bool CompilationContext::IsLibrary(std::string_view name)
+	{
+		std::lock_guard lock(mMutex);
+		for (auto& lib : mLibraries)
+			if (lib == name)
+				return true;
+		return false;
+	}
+
+	void CompilationContext::AddLibrary(std::string_view name)
+	{
+		std::lock_guard lock(mMutex);
+		mLibraries.push_back(std::string(name));
+	}
+
+	void CompilationContext::AddUnit(std::string_view asmPath)
+	{
+		std::lock_guard lock(mMutex);
+		mUnits.push_back(std::string(asmPath));
+	}
+
+	void CompilationContext::AddPending(std::future<bool> job)
+	{
+		std::lock_guard lock(mMutex);
+		mPending.push_back(std::move(job));
+	}
+
+	bool CompilationContext::WaitPending()
+	{
+		bool succeeded = true;
+		while (true)
+		{
+			std::vector<std::future<bool>> pending;
+			{
+				std::lock_guard lock(mMutex);
+				pending.swap(mPending);
+			}
+			if (pending.empty())
+				return succeeded;
+
+			for (auto& job : pending)
+				if (!Util::ThreadPool::Get().Wait(job))
+					succeeded = false;
+		}
+	}
+
+	std::vector<std::string>& CompilationContext::GetLibraries()
+	{ return mLibraries; }
+
+	std::vector<std::string>& CompilationContext::GetUnits()
+	{ return mUnits; }
+}
@@ -1,27 +1,43 @@
 #include "SympleCode/Compiler.h"
 
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <unordered_map>
 
 #include <spdlog/spdlog.h>
 
 #include "SympleCode/Syntax/Lexer.h"
 #include "SympleCode/Syntax/Parser.h"
+#include "SympleCode/Syntax/TreeCache.h"
 #include "SympleCode/Binding/Binder.h"
+#include "SympleCode/Binding/SymbolCache.h"
 #include "SympleCode/Emit/AsmEmitter.h"
 #include "SympleCode/Util/ConsoleColor.h"
+#include "SympleCode/Util/Scan.h"
+#include "SympleCode/Util/ThreadPool.h"
 
 namespace Symple
 {
-	std::vector<std::string> Compiler::sLibraries;
-	std::vector<std::string> Compiler::sUnits;
-
-	Compiler::Compiler(char *path)
-		: mPath(path)
+	// A file in the import graph
+	struct ImportUnit
+	{
+		std::string Path;
+		shared_ptr<Compiler> Unit;
+		std::vector<Binding::SymbolCache::Import> Imports;
+		std::vector<ImportUnit*> Dependents;
+		// Imports that aren't done yet
+		std::atomic<unsigned> Waiting = 0;
+		std::atomic<bool> Failed = false;
+	};
+
+	Compiler::Compiler(char *path, shared_ptr<CompilationContext> context)
+		: mPath(path), mContext(context)
 	{
 		// Store output folder
-		mAsmPath = mPath.substr(0, mPath.find_first_of('/')) +
-			"/bin" + mPath.substr(mPath.find_first_of('/'),
-				mPath.find_last_of('.') - mPath.find_first_of('/')) + ".S";
+		mAsmPath = GetOutputPath(mPath, ".S");
+		mCachePath = GetOutputPath(mPath, ".ast");
+		mSymbolPath = GetOutputPath(mPath, ".sym");
 
 		// Make sure output path exists
 		unsigned last = 0;
@@ -39,38 +55,64 @@ namespace Symple
 		if (mAnyErrors)
 			return nullptr;
 
-		unique_ptr<Syntax::Lexer> lexer = make_unique<Syntax::Lexer>((char*)mPath.c_str());
-		mTokens.clear();
-
-		do
-			mTokens.push_back(lexer->Lex());
-		while (!mTokens.back()->Is(Syntax::Token::EndOfFile));
+		// Files that haven't changed since they were last parsed cleanly skip lexing and parsing altogether
+		auto source = make_shared<Util::MappedFile>((char*)mPath.c_str());
+		if (mAST = Syntax::TreeCache::Load((char*)mCachePath.c_str(), (char*)mPath.c_str(), source))
+		{
+			spdlog::debug("Loaded '{}' from '{}'", mPath, mCachePath);
+			return make_shared<DiagnosticBag>();
+		}
 
-		if (PrintDiagnosticBag(lexer->GetDiagnosticBag(), "Lexing"))
-			return lexer->GetDiagnosticBag();
+		mLexer = make_shared<Syntax::Lexer>((char*)mPath.c_str(), source);
 
+		// Large files are lexed across threads up front, otherwise the parser pulls tokens from the lexer as it goes
 #if __SY_DEBUG
+		auto tokens = mLexer->GetTokens();
+		auto start = std::chrono::steady_clock::now();
+		if (!mLexer->LexParallel())
+			while (!mLexer->Lex().Is(Syntax::Token::EndOfFile));
+		std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+		spdlog::debug("Lexed {} bytes into {} tokens in {:.3f}ms ({} scanning)", mLexer->GetSource().length(), tokens->GetCount(),
+			time.count(), Util::GetScanLevelName(Util::GetScanLevel()));
+
+		if (PrintDiagnosticBag(mLexer->GetDiagnosticBag(), "Lexing"))
+			return mLexer->GetDiagnosticBag();
+
 		std::stringstream ss;
-		for (auto tok : mTokens)
+		for (unsigned i = 0; i < tokens->GetCount(); i++)
 		{
-			tok->Print(ss, "", tok->Is(Syntax::Token::EndOfFile));
+			Syntax::Token tok = tokens->Get(i);
+			tok.Print(ss, "", tok.Is(Syntax::Token::EndOfFile));
 			ss.put('\n');
 		}
 		spdlog::debug("Lex Tokens:\n{}", ss.str());
+#else
+		mLexer->LexParallel();
 #endif
 
-		return lexer->GetDiagnosticBag();
+		return mLexer->GetDiagnosticBag();
 	}
 
 	shared_ptr<DiagnosticBag> Compiler::Parse()
 	{
 		if (mAnyErrors)
 			return nullptr;
+		if (!mLexer)
+			return make_shared<DiagnosticBag>();
 
-		unique_ptr<Syntax::Parser> parser = make_unique<Syntax::Parser>(mTokens);
+		unique_ptr<Syntax::Parser> parser = make_unique<Syntax::Parser>(mLexer);
 		mAST = parser->Parse();
+#if !__SY_DEBUG
+		if (PrintDiagnosticBag(mLexer->GetDiagnosticBag(), "Lexing"))
+			return mLexer->GetDiagnosticBag();
+#endif
+		// Only clean trees are cached, a hit doesn't replay any diagnostics
+		bool clean = mLexer->GetDiagnosticBag()->GetDiagnostics().empty() && parser->GetDiagnosticBag()->GetDiagnostics().empty();
+		mLexer.reset();
 		if (PrintDiagnosticBag(parser->GetDiagnosticBag(), "Parsing"))
 			return parser->GetDiagnosticBag();
+		if (clean)
+			Syntax::TreeCache::Store((char*)mCachePath.c_str(), mAST);
 
 #if __SY_DEBUG
 		std::stringstream ss;
@@ -82,13 +124,180 @@ namespace Symple
 		return parser->GetDiagnosticBag();
 	}
 
+	void Compiler::CompileImports()
+	{
+		if (mAnyErrors || !mAST)
+			return;
+
+		Util::ThreadPool& pool = Util::ThreadPool::Get();
+		std::unordered_map<std::string, unique_ptr<ImportUnit>> units;
+		std::vector<ImportUnit*> found;
+
+		// Find every file below this one a level at a time, scanning each level across threads
+		std::vector<Binding::SymbolCache::Import> level;
+		for (auto member : mAST->GetMembers())
+			if (member->GetKind() == Syntax::Node::ImportStatement)
+			{
+				auto import = dynamic_pointer_cast<Syntax::ImportStatementSyntax>(member);
+				level.push_back({ Binding::Binder::GetImportPath(import), std::string(import->GetImport().GetText()) });
+			}
+		while (!level.empty())
+		{
+			std::vector<ImportUnit*> scanned;
+			for (auto& import : level)
+			{
+				if (units.count(import.Path) || _access(import.Path.c_str(), 0) == -1 || mContext->GetImport(import.Path))
+					continue;
+
+				auto& unit = units[import.Path] = make_unique<ImportUnit>();
+				unit->Path = import.Path;
+				unit->Unit = make_shared<Compiler>((char*)import.Path.c_str(), mContext);
+				scanned.push_back(unit.get());
+			}
+
+			std::vector<std::future<void>> jobs;
+			for (auto unit : scanned)
+				jobs.push_back(pool.Submit([unit]() { unit->Imports = unit->Unit->ScanImports(); }));
+			level.clear();
+			for (unsigned i = 0; i < scanned.size(); i++)
+			{
+				pool.Wait(jobs[i]);
+				level.insert(level.end(), scanned[i]->Imports.begin(), scanned[i]->Imports.end());
+			}
+			found.insert(found.end(), scanned.begin(), scanned.end());
+		}
+		if (found.empty())
+			return;
+
+		for (auto unit : found)
+			for (auto& import : unit->Imports)
+			{
+				auto dependency = units.find(import.Path);
+				if (dependency != units.end())
+				{
+					dependency->second->Dependents.push_back(unit);
+					unit->Waiting++;
+				}
+			}
+
+		// Dependencies before the files that import them, which is also the order they're linked in
+		std::vector<ImportUnit*> order, roots;
+		std::unordered_map<ImportUnit*, unsigned> waiting;
+		for (auto unit : found)
+			if (!(waiting[unit] = unit->Waiting))
+				order.push_back(unit);
+		roots = order;
+		for (unsigned i = 0; i < order.size(); i++)
+			for (auto dependent : order[i]->Dependents)
+				if (!--waiting[dependent])
+					order.push_back(dependent);
+		if (order.size() != found.size())
+		{
+			for (auto unit : found)
+				if (waiting[unit])
+					spdlog::error("Circular import '{}'", unit->Path);
+			mAnyErrors = true;
+			return;
+		}
+
+		// Each unit starts the ones waiting on it, so nothing ever blocks on a dependency
+		std::atomic<unsigned> remaining = found.size();
+		auto done = make_shared<std::promise<void>>();
+		std::future<void> finished = done->get_future();
+		std::function<void(ImportUnit*)> compile = [&pool, &remaining, &compile, done](ImportUnit* unit)
+		{
+			pool.Submit([&remaining, &compile, done, unit]()
+				{
+					if (!unit->Failed)
+					{
+						auto tree = CompileImport(unit->Unit);
+						unit->Failed = !tree;
+						if (tree)
+						{
+							unit->Unit->mContext->AddImport(unit->Path, tree);
+							spdlog::info("Imported '{}'", unit->Path);
+						}
+						else
+							spdlog::error("Failed to import '{}'", unit->Path);
+					}
+					else
+						spdlog::error("Skipped '{}', something it imports failed", unit->Path);
+
+					for (auto dependent : unit->Dependents)
+					{
+						if (unit->Failed)
+							dependent->Failed = true;
+						if (!--dependent->Waiting)
+							compile(dependent);
+					}
+					if (!--remaining)
+						done->set_value();
+				});
+		};
+		for (auto unit : roots)
+			compile(unit);
+		pool.Wait(finished);
+
+		for (auto unit : order)
+			if (unit->Failed)
+				mAnyErrors = true;
+			else
+				mContext->AddUnit(unit->Unit->mAsmPath);
+	}
+
+	std::vector<Binding::SymbolCache::Import> Compiler::ScanImports()
+	{
+		// If they turn out to be stale, binding compiles whatever else it imports by itself
+		std::vector<Binding::SymbolCache::Import> imports;
+		if (Binding::SymbolCache::LoadImports((char*)mSymbolPath.c_str(), imports))
+			return imports;
+
+		Lex();
+		Parse();
+		if (mAST)
+			for (auto member : mAST->GetMembers())
+				if (member->GetKind() == Syntax::Node::ImportStatement)
+				{
+					auto import = dynamic_pointer_cast<Syntax::ImportStatementSyntax>(member);
+					imports.push_back({ Binding::Binder::GetImportPath(import), std::string(import->GetImport().GetText()) });
+				}
+		return imports;
+	}
+
+	shared_ptr<Binding::BoundCompilationUnit> Compiler::CompileImport(shared_ptr<Compiler> compiler)
+	{
+		if (compiler->LoadSymbols())
+			return compiler->mTree;
+
+		if (!compiler->mAST)
+		{
+			compiler->Lex();
+			compiler->Parse();
+		}
+		auto symbols = compiler->BindSymbols();
+		if (compiler->mAnyErrors)
+			return nullptr;
+
+		// Importers only need the declarations, the bodies are bound, emitted and compiled off to the side
+		compiler->mContext->AddPending(Util::ThreadPool::Get().Submit([compiler]()
+			{
+				compiler->Bind();
+				compiler->Emit();
+				compiler->Compile();
+				compiler->StoreSymbols();
+				return !compiler->mAnyErrors;
+			}));
+		return symbols;
+	}
+
 	shared_ptr<DiagnosticBag> Compiler::Bind()
 	{
 		if (mAnyErrors)
 			return nullptr;
 
-		shared_ptr<Binding::Binder> binder = make_shared<Binding::Binder>();
+		shared_ptr<Binding::Binder> binder = make_shared<Binding::Binder>(mContext);
 		mTree = binder->Bind(mAST);
+		mImports = binder->GetImports();
 		if (PrintDiagnosticBag(binder->GetDiagnosticBag(), "Binding"))
 			return binder->GetDiagnosticBag();
 
@@ -110,10 +319,18 @@ namespace Symple
 		if (mAnyErrors)
 			return nullptr;
 
-		shared_ptr<Binding::Binder> binder = make_shared<Binding::Binder>();
+		shared_ptr<Binding::Binder> binder = make_shared<Binding::Binder>(mContext);
 		mTree = binder->BindSymbols(mAST);
-		if (PrintDiagnosticBag(binder->GetDiagnosticBag(), "Importing"))
+		// The whole file is bound after and reports these again, so they're only printed if that won't happen
+		if (binder->GetDiagnosticBag()->GetErrorCount())
+		{
+			PrintDiagnosticBag(binder->GetDiagnosticBag(), "Importing");
 			return mTree;
+		}
+
+		// Importers are keyed by this, so they don't have to wait on this file's own entry being written
+		mImports = binder->GetImports();
+		mContext->SetKey(mPath, Binding::SymbolCache::GetKey((char*)mPath.c_str(), mImports, mContext));
 
 #if __SY_DEBUG
 		std::stringstream ss;
@@ -128,6 +345,27 @@ namespace Symple
 		return mTree;
 	}
 
+	bool Compiler::LoadSymbols()
+	{
+		if (mAnyErrors || _access(GetOutputPath(mPath, ".obj").c_str(), 0) == -1)
+			return false;
+
+		if (mTree = Binding::SymbolCache::Load((char*)mSymbolPath.c_str(), (char*)mPath.c_str(), mContext))
+		{
+			spdlog::debug("Loaded '{}' from '{}'", mPath, mSymbolPath);
+			return true;
+		}
+		return false;
+	}
+
+	bool Compiler::StoreSymbols()
+	{
+		if (mAnyErrors || !mTree)
+			return false;
+
+		return Binding::SymbolCache::Store((char*)mSymbolPath.c_str(), (char*)mPath.c_str(), mTree, mImports, mContext);
+	}
+
 	void Compiler::Emit()
 	{
 		if (mAnyErrors)
@@ -148,21 +386,32 @@ namespace Symple
 
 	bool Compiler::Link(std::string_view output, bool isLib)
 	{
+		// Their object files have to be there
+		if (!mContext->WaitPending())
+			mAnyErrors = true;
+
 		if (mAnyErrors)
 			return false;
 
 		std::stringstream linkcmd;
 		linkcmd << "clang -m32 --optimize" << (isLib ? " -shared" : "") << " -o " << output << ' ' << mAsmPath.substr(0, mAsmPath.find_last_of('.')) << ".obj";
-		for (auto unit : sUnits)
+		for (auto unit : mContext->GetUnits())
 			linkcmd << ' ' << unit.substr(0, unit.find_last_of('.')) << ".obj";
-		for (auto lib : sLibraries)
+		for (auto lib : mContext->GetLibraries())
 			linkcmd << " -l " << lib;
 
-		sUnits.clear();
-		sLibraries.clear();
-
 		return !system(linkcmd.str().c_str());
 	}
+
+	shared_ptr<CompilationContext> Compiler::GetContext()
+	{ return mContext; }
+
+	std::string Compiler::GetOutputPath(std::string_view path, std::string_view extension)
+	{
+		std::string_view folder = path.substr(0, path.find_first_of('/'));
+		std::string_view file = path.substr(path.find_first_of('/'), path.find_last_of('.') - path.find_first_of('/'));
+		return std::string(folder) + "/bin" + std::string(file) + std::string(extension);
+	}
 	
 	int Compiler::Exec(std::string_view args)
 	{
@@ -191,13 +440,13 @@ namespace Symple
 			switch (diagnostic->GetLevel())
 			{
 			case Diagnostic::Message:
-				spdlog::info("'{}' {}:{} \"{}\"", diagnostic->GetToken()->GetFile(), diagnostic->GetToken()->GetLine(), diagnostic->GetToken()->GetColumn(), diagnostic->GetMessage());
+				spdlog::info("'{}' {}:{} \"{}\"", diagnostic->GetToken().GetFile(), diagnostic->GetToken().GetLine(), diagnostic->GetToken().GetColumn(), diagnostic->GetMessage());
 				break;
 			case Diagnostic::Warning:
-				spdlog::warn("'{}' {}:{} \"{}\"", diagnostic->GetToken()->GetFile(), diagnostic->GetToken()->GetLine(), diagnostic->GetToken()->GetColumn(), diagnostic->GetMessage());
+				spdlog::warn("'{}' {}:{} \"{}\"", diagnostic->GetToken().GetFile(), diagnostic->GetToken().GetLine(), diagnostic->GetToken().GetColumn(), diagnostic->GetMessage());
 				break;
 			case Diagnostic::Error:
-				spdlog::error("'{}' {}:{} \"{}\"", diagnostic->GetToken()->GetFile(), diagnostic->GetToken()->GetLine(), diagnostic->GetToken()->GetColumn(), diagnostic->GetMessage());
+				spdlog::error("'{}' {}:{} \"{}\"", diagnostic->GetToken().GetFile(), diagnostic->GetToken().GetLine(), diagnostic->GetToken().GetColumn(), diagnostic->GetMessage());
 				break;
 			}
 
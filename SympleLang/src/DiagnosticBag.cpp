@@ -8,19 +8,19 @@ namespace Symple
 {
 	using namespace Syntax;
 
-	void DiagnosticBag::ReportMessage(shared_ptr<Token> tok, std::string_view msg)
+	void DiagnosticBag::ReportMessage(Token tok, std::string_view msg)
 	{
 		mDiagnostics.push_back(make_shared<Diagnostic>(Diagnostic::Message, tok, msg));
 		mMessageCount++;
 	}
 
-	void DiagnosticBag::ReportWarning(shared_ptr<Token> tok, std::string_view msg)
+	void DiagnosticBag::ReportWarning(Token tok, std::string_view msg)
 	{
 		mDiagnostics.push_back(make_shared<Diagnostic>(Diagnostic::Warning, tok, msg));
 		mWarningCount++;
 	}
 
-	void DiagnosticBag::ReportError(shared_ptr<Token> tok, std::string_view msg)
+	void DiagnosticBag::ReportError(Token tok, std::string_view msg)
 	{
 		mDiagnostics.push_back(make_shared<Diagnostic>(Diagnostic::Error, tok, msg));
 		mErrorCount++;
@@ -40,15 +40,23 @@ namespace Symple
 	std::vector<shared_ptr<Diagnostic>>& DiagnosticBag::GetDiagnostics()
 	{ return mDiagnostics; }
 
+	void DiagnosticBag::Append(DiagnosticBag& other)
+	{
+		mDiagnostics.insert(mDiagnostics.end(), other.mDiagnostics.begin(), other.mDiagnostics.end());
+		mMessageCount += other.mMessageCount;
+		mWarningCount += other.mWarningCount;
+		mErrorCount += other.mErrorCount;
+	}
+
 
 #if __SY_ALLOW_UNIMPLIMENTED
-	void DiagnosticBag::ReportUnimplimentedMessage(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUnimplimentedMessage(Syntax::Token tok)
 	{ ReportWarning(tok, "message not implemented"); }
 
-	void DiagnosticBag::ReportUnimplimentedWarning(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUnimplimentedWarning(Syntax::Token tok)
 	{ ReportWarning(tok, "warning not implemented"); }
 
-	void DiagnosticBag::ReportUnimplimentedError(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUnimplimentedError(Syntax::Token tok)
 	{ ReportWarning(tok, "error not implemented"); }
 #endif
 
@@ -73,33 +81,33 @@ namespace Symple
 	{ ReportError(syntax->GetToken(), "function Doesn't Exist"); }
 
 
-	void DiagnosticBag::ReportUndeclaredLabel(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUndeclaredLabel(Syntax::Token tok)
 	{ ReportError(tok, "undeclared label"); }
 
-	void DiagnosticBag::ReportUnexpectedEndOfFile(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUnexpectedEndOfFile(Syntax::Token tok)
 	{ ReportError(tok, "unexpected end of file"); }
 
-	void DiagnosticBag::ReportUnexpectedDllImportBody(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUnexpectedDllImportBody(Syntax::Token tok)
 	{ ReportError(tok, "unexpected dllimport body"); }
 
-	void DiagnosticBag::ReportUndeclaredIdentifier(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportUndeclaredIdentifier(Syntax::Token tok)
 	{ ReportError(tok, "undeclared identifier"); }
 
-	void DiagnosticBag::ReportUnexpectedToken(shared_ptr<Token> tok, Token::Kind expected)
+	void DiagnosticBag::ReportUnexpectedToken(Token tok, Token::Kind expected)
 	{
 		std::stringstream tokStr;
-		tok->PrintShort(tokStr);
+		tok.PrintShort(tokStr);
 		ReportError(tok, fmt::format("unexpected token '{}', expected {}", tokStr.str(), Token::KindMap[expected]));
 	}
 
-	void DiagnosticBag::ReportUnknownToken(shared_ptr<Syntax::Token> tok)
-	{ ReportError(tok, fmt::format("unknown token '{}'", tok->GetText())); }
+	void DiagnosticBag::ReportUnknownToken(Syntax::Token tok)
+	{ ReportError(tok, fmt::format("unknown token '{}'", tok.GetText())); }
 
 
-	void DiagnosticBag::ReportInvalidOperation(shared_ptr<Syntax::Token> tok, shared_ptr<Symbol::TypeSymbol> l, shared_ptr<Symbol::TypeSymbol> r)
+	void DiagnosticBag::ReportInvalidOperation(Syntax::Token tok, shared_ptr<Symbol::TypeSymbol> l, shared_ptr<Symbol::TypeSymbol> r)
 	{
 		std::stringstream ss;
-		tok->PrintShort(ss);
+		tok.PrintShort(ss);
 		std::string tokstr = ss.str();
 		
 		ss.str({}); // Clear stream
@@ -112,10 +120,10 @@ namespace Symple
 		ReportError(tok, fmt::format("invalid operation [{}] of types {}, and {}", tokstr, lstr, rstr));
 	}
 
-	void DiagnosticBag::ReportInvalidOperation(shared_ptr<Syntax::Token> tok, shared_ptr<Symbol::TypeSymbol> ty)
+	void DiagnosticBag::ReportInvalidOperation(Syntax::Token tok, shared_ptr<Symbol::TypeSymbol> ty)
 	{
 		std::stringstream ss;
-		tok->PrintShort(ss);
+		tok.PrintShort(ss);
 		std::string tokstr = ss.str();
 
 		ss.str({}); // Clear stream
@@ -125,16 +133,16 @@ namespace Symple
 	}
 
 
-	void DiagnosticBag::ReportExpectedUnqualifiedID(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportExpectedUnqualifiedID(Syntax::Token tok)
 	{ ReportError(tok, "expected unqualidied-id"); }
 
-	void DiagnosticBag::ReportExpectedLValue(shared_ptr<Syntax::Token> tok)
+	void DiagnosticBag::ReportExpectedLValue(Syntax::Token tok)
 	{ ReportError(tok, "expected lvalue"); }
 
 	void DiagnosticBag::ReportInvalidLiteral(shared_ptr<LiteralExpressionSyntax> literal)
 	{
 		std::stringstream tokStr;
-		literal->GetLiteral()->PrintShort(tokStr);
+		literal->GetLiteral().PrintShort(tokStr);
 		ReportError(literal->GetLiteral(), fmt::format("invalid literal '{}'", tokStr.str()));
 	}
 }
\ No newline at end of file
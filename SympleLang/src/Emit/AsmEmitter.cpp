@@ -10,10 +10,10 @@
 namespace Symple::Emit
 {
 	void AsmEmitter::BeginScope()
-	{ mScope = make_shared<Scope>(mScope); }
+	{ mScope.BeginScope(); }
 
 	void AsmEmitter::EndScope()
-	{ mScope = mScope->GetBase(); }
+	{ mScope.EndScope(); }
 
 	char* AsmEmitter::RegAx(unsigned sz)
 	{
@@ -150,8 +150,8 @@ namespace Symple::Emit
 		for (auto param : func->GetParameters())
 		{
 			stackPos += 4;
-			_Emit(Text, "_%s$%i = %i", param->GetName().data(), mScope->GetDepth(), stackPos);
-			mScope->DeclareVariable(param);
+			_Emit(Text, "_%s$%i = %i", param->GetName().data(), mScope.GetDepth(), stackPos);
+			mScope.DeclareVariable(param);
 		}
 
 		mReturning = false;
@@ -215,7 +215,7 @@ namespace Symple::Emit
 	{ _Emit(Text, "%s.%s:", mFunctionAssemblyName.c_str(), stmt->GetLabel().data()); }
 
 	void AsmEmitter::EmitNativeCode(shared_ptr<Binding::BoundNativeCode> stmt)
-	{ _Emit(Text, "%s", stmt->GetAssembly().data()); }
+	{ _Emit(Text, "%.*s", (int)stmt->GetAssembly().length(), stmt->GetAssembly().data()); }
 
 	void AsmEmitter::EmitIfStatement(shared_ptr<Binding::BoundIfStatement> stmt)
 	{
@@ -235,7 +235,7 @@ namespace Symple::Emit
 	}
 
 	void AsmEmitter::EmitGotoStatement(shared_ptr<Binding::BoundGotoStatement> stmt)
-	{ _Emit(Text, "\tjmp     %s.%s", mFunctionAssemblyName.c_str(), stmt->GetLabel().data()); }
+	{ _Emit(Text, "\tjmp     %s.%.*s", mFunctionAssemblyName.c_str(), (int)stmt->GetLabel().length(), stmt->GetLabel().data()); }
 
 	void AsmEmitter::EmitBlockStatement(shared_ptr<Binding::BoundBlockStatement> stmt)
 	{
@@ -264,15 +264,15 @@ namespace Symple::Emit
 		std::string_view name = stmt->GetSymbol()->GetName();
 		unsigned sz = stmt->GetSymbol()->GetType()->GetSize();
 		Alloc(sz);
-		_Emit(Text, "_%s$%i = -%i", name.data(), mScope->GetDepth(), mStackUsage);
+		_Emit(Text, "_%s$%i = -%i", name.data(), mScope.GetDepth(), mStackUsage);
 
 		if (stmt->GetInitializer())
 		{
 			EmitExpression(stmt->GetInitializer());
-			_Emit(Text, "\tmov     %s, _%s$%i(%%ebp)", RegAx(sz), name.data(), mScope->GetDepth());
+			_Emit(Text, "\tmov     %s, _%s$%i(%%ebp)", RegAx(sz), name.data(), mScope.GetDepth());
 		}
 
-		mScope->DeclareVariable(stmt->GetSymbol());
+		mScope.DeclareVariable(stmt->GetSymbol());
 	}
 
 
@@ -289,15 +289,16 @@ namespace Symple::Emit
 		else if (expr->GetType()->Equals(Symbol::TypeSymbol::CharPointerType) && expr->Is(Binding::Node::LiteralExpression)) // String Literal
 		{
 			for (unsigned i = 0; i < mStringLiterals.size(); i++)
-				if (mStringLiterals[i] == expr->GetSyntax()->GetToken()->GetText())
+				if (mStringLiterals[i] == expr->GetSyntax()->GetToken().GetText())
 				{
 					_Emit(Text, "\tlea     ..%i, %%eax", i);
 					return expr->GetType();
 				}
 
 			_Emit(Data, "..%i:", mDataCount);
-			_Emit(Data, "\t.string \"%s\"", expr->GetSyntax()->GetToken()->GetText().data());
-			mStringLiterals.push_back(std::string(expr->GetSyntax()->GetToken()->GetText()));
+			std::string_view str = expr->GetSyntax()->GetToken().GetText();
+			_Emit(Data, "\t.string \"%.*s\"", (int)str.length(), str.data());
+			mStringLiterals.push_back(std::string(expr->GetSyntax()->GetToken().GetText()));
 
 			_Emit(Text, "\tlea     ..%i, %%eax", mDataCount++);
 			return expr->GetType();
@@ -413,7 +414,7 @@ namespace Symple::Emit
 
 	shared_ptr<Symbol::TypeSymbol> AsmEmitter::EmitVariableExpression(shared_ptr<Binding::BoundVariableExpression> expr)
 	{
-		shared_ptr<Symbol::VariableSymbol> var = mScope->GetVariableSymbol(expr->GetSymbol()->GetName());
+		shared_ptr<Symbol::VariableSymbol> var = mScope.GetVariableSymbol(expr->GetSymbol()->GetAtom());
 		if (var != expr->GetSymbol())
 		{
 			abort(); // Something bad, happening in code...
@@ -421,7 +422,7 @@ namespace Symple::Emit
 		}
 
 		std::string_view name = var->GetName();
-		unsigned depth = mScope->GetVariableDepth(var->GetName());
+		unsigned depth = mScope.GetVariableDepth(var->GetAtom());
 		unsigned sz = var->GetType()->GetSize();
 		_Emit(Text, "\tmov     _%s$%i(%%ebp), %s", name.data(), depth, RegAx(sz));
 		if (sz <= 2)
@@ -445,11 +446,11 @@ namespace Symple::Emit
 
 	shared_ptr<Symbol::TypeSymbol> AsmEmitter::EmitVariableExpressionPointer(shared_ptr<Binding::BoundVariableExpression> expr)
 	{
-		shared_ptr<Symbol::VariableSymbol> var = mScope->GetVariableSymbol(expr->GetSymbol()->GetName());
+		shared_ptr<Symbol::VariableSymbol> var = mScope.GetVariableSymbol(expr->GetSymbol()->GetAtom());
 		__SY_ASSERT(var == expr->GetSymbol(), "Internal Error");
 
 		std::string_view name = var->GetName();
-		unsigned depth = mScope->GetVariableDepth(var->GetName());
+		unsigned depth = mScope.GetVariableDepth(var->GetAtom());
 		_Emit(Text, "\tlea     _%s$%i(%%ebp), %%eax", name.data(), depth);
 
 		return var->GetType();
@@ -45,9 +45,10 @@ int main()
 {
 	SetupLogging();
 
-	unique_ptr<Symple::Compiler> compiler = make_unique<Symple::Compiler>((char*)"sy/Main.sy");
+	unique_ptr<Symple::Compiler> compiler = make_unique<Symple::Compiler>((char*)"sy/Main.sy", make_shared<Symple::CompilationContext>());
 	compiler->Lex();
 	compiler->Parse();
+	compiler->CompileImports();
 	compiler->Bind();
 	compiler->Emit();
 	compiler->Compile();
@@ -0,0 +1,17 @@
+#include "SympleCode/Symbol/StructTypeSymbol.h"
+
+namespace Symple::Symbol
+{
+	bool StructTypeSymbol::Matches(unsigned sz, MemberList& members)
+	{
+		if (GetSize() != sz || mMembers.size() != members.size())
+			return false;
+		for (unsigned i = 0; i < members.size(); i++)
+		{
+			auto init = mMembers[i]->GetInitializer(), otherInit = members[i]->GetInitializer();
+			if (mMembers[i]->GetAtom() != members[i]->GetAtom() || !mMembers[i]->GetType()->Equals(members[i]->GetType()) || (init ? !init->Equals(otherInit) : !!otherInit))
+				return false;
+		}
+		return true;
+	}
+}
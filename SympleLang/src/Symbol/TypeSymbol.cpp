@@ -18,21 +18,66 @@ namespace Symple::Symbol
 	shared_ptr<TypeSymbol> TypeSymbol::DoubleType = make_shared<TypeSymbol>(Double, "double", 8, true);
 	shared_ptr<TypeSymbol> TypeSymbol::TripleType = make_shared<TypeSymbol>(Triple, "triple", 16, true);
 
-	shared_ptr<TypeSymbol> TypeSymbol::VoidPointerType = make_shared<TypeSymbol>(Void, "void", 4, false, 1);
-	shared_ptr<TypeSymbol> TypeSymbol::BytePointerType = make_shared<TypeSymbol>(Byte, "byte", 4, false, 1);
-	shared_ptr<TypeSymbol> TypeSymbol::CharPointerType = make_shared<TypeSymbol>(Char, "char", 4, false, 1);
+	shared_ptr<TypeSymbol> TypeSymbol::VoidPointerType = MakePointerType(VoidType, 1);
+	shared_ptr<TypeSymbol> TypeSymbol::BytePointerType = MakePointerType(ByteType, 1);
+	shared_ptr<TypeSymbol> TypeSymbol::CharPointerType = MakePointerType(CharType, 1);
 
-	TypeSymbol::TypeSymbol(TypeKind kind, std::string_view name, unsigned sz, bool isFloat, unsigned pointerCount, std::vector<char> mods)
+	shared_ptr<TypeSymbol> TypeSymbol::MakePointerType(shared_ptr<TypeSymbol> base, unsigned pointerCount)
+	{
+		if (base->mBase)
+			base = base->mBase;
+		if (!pointerCount)
+			return base;
+
+		auto type = make_shared<TypeSymbol>(base->GetTypeKind(), base->GetAtom(), base->mSize, base->IsFloat(), pointerCount, base->GetModifiers());
+		type->mBase = base;
+		return type;
+	}
+
+	TypeSymbol::TypeSymbol(TypeKind kind, Util::Atom name, unsigned sz, bool isFloat, unsigned pointerCount, std::vector<char> mods)
 		: mTypeKind(kind), mName(name), mSize(sz), mFloat(isFloat), mPointerCount(pointerCount), mModifiers(mods)
 	{}
 
 
-	bool TypeSymbol::Equals(shared_ptr<TypeSymbol> other)
+	shared_ptr<TypeSymbol> TypeSymbol::GetBuiltinType(TypeKind kind)
 	{
-		return GetPointerCount() == other->GetPointerCount() && Is(other->GetTypeKind());
+		switch (kind)
+		{
+		case Void:
+			return VoidType;
+		case Byte:
+			return ByteType;
+		case Short:
+			return ShortType;
+		case Int:
+			return IntType;
+		case Long:
+			return LongType;
+
+		case Bool:
+			return BoolType;
+		case Char:
+			return CharType;
+		case WChar:
+			return WCharType;
+
+		case Float:
+			return FloatType;
+		case Double:
+			return DoubleType;
+		case Triple:
+			return TripleType;
+
+		default:
+			return ErrorType;
+		}
 	}
 
 
+	bool TypeSymbol::Equals(shared_ptr<TypeSymbol> other)
+	{ return this == other.get(); }
+
+
 	bool TypeSymbol::Is(TypeKind kind)
 	{ return mTypeKind == kind; }
 
@@ -61,6 +106,9 @@ namespace Symple::Symbol
 	{ return mTypeKind; }
 
 	std::string_view TypeSymbol::GetName()
+	{ return mName.GetText(); }
+
+	Util::Atom TypeSymbol::GetAtom()
 	{ return mName; }
 
 	unsigned TypeSymbol::GetSize()
@@ -75,4 +123,7 @@ namespace Symple::Symbol
 
 	std::vector<char> &TypeSymbol::GetModifiers()
 	{ return mModifiers; }
+
+	shared_ptr<TypeSymbol> TypeSymbol::GetBase()
+	{ return mBase; }
 }
\ No newline at end of file
@@ -2,6 +2,130 @@
 
 namespace Symple::Syntax
 {
+	struct Keyword
+	{
+		std::string_view Text;
+		Token::Kind Kind;
+	};
+
+	static constexpr Keyword sKeywords[] = {
+		{ "void", Token::VoidKeyword },
+		{ "byte", Token::ByteKeyword },
+		{ "short", Token::ShortKeyword },
+		{ "int", Token::IntKeyword },
+		{ "integer", Token::IntKeyword },
+		{ "long", Token::LongKeyword },
+
+		{ "bool", Token::BoolKeyword },
+		{ "boolean", Token::BoolKeyword },
+		{ "char", Token::CharKeyword },
+		{ "wchar", Token::WCharKeyword },
+		{ "wchar_t", Token::WCharKeyword },
+
+		{ "float", Token::FloatKeyword },
+		{ "double", Token::DoubleKeyword },
+		{ "triple", Token::TripleKeyword },
+
+		{ "ret", Token::ReturnKeyword },
+		{ "return", Token::ReturnKeyword },
+
+		{ "default", Token::DefaultKeyword },
+		{ "extern", Token::ExternKeyword },
+		{ "external", Token::ExternKeyword },
+
+		{ "link", Token::ImportKeyword },
+		{ "import", Token::ImportKeyword },
+		{ "cdecl", Token::CDeclKeyword },
+		{ "__cdecl", Token::CDeclKeyword },
+		{ "stdcall", Token::StdCallKeyword },
+		{ "__stdcall", Token::StdCallKeyword },
+
+		{ "dllimport", Token::DllImportKeyword },
+		{ "__dllimport", Token::DllImportKeyword },
+		{ "dllexport", Token::DllExportKeyword },
+		{ "__dllexport", Token::DllExportKeyword },
+
+		{ "static", Token::StaticKeyword },
+		{ "local", Token::LocalKeyword },
+		{ "private", Token::LocalKeyword },
+		{ "globl", Token::GlobalKeyword },
+		{ "global", Token::GlobalKeyword },
+		{ "public", Token::GlobalKeyword },
+
+		{ "__asm", Token::NativeKeyword },
+		{ "native", Token::NativeKeyword },
+		{ "goto", Token::GotoKeyword },
+
+		{ "if", Token::IfKeyword },
+		{ "else", Token::ElseKeyword },
+
+		{ "struct", Token::StructKeyword },
+		{ "structure", Token::StructKeyword },
+	};
+
+	static constexpr unsigned sKeywordCount = sizeof(sKeywords) / sizeof(*sKeywords);
+	static constexpr unsigned sKeywordSlotCount = 256;
+	static constexpr unsigned sMinKeywordLength = 2;
+	static constexpr unsigned sMaxKeywordLength = 11;
+
+	// Only looks at the length and four characters, so every lookup costs a single string compare
+	static constexpr unsigned HashKeyword(std::string_view text, unsigned seed)
+	{
+		unsigned hash = (unsigned)text.length();
+		hash = (hash ^ (unsigned char)text[0]) * seed;
+		hash = (hash ^ (unsigned char)text[1]) * seed;
+		hash = (hash ^ (unsigned char)text[text.length() / 2]) * seed;
+		hash = (hash ^ (unsigned char)text[text.length() - 1]) * seed;
+		hash ^= hash >> 15;
+		return hash % sKeywordSlotCount;
+	}
+
+	struct KeywordTable
+	{
+		unsigned Seed = 0;
+		unsigned char Slots[sKeywordSlotCount] = {}; // Index into sKeywords + 1, 0 is empty
+	};
+
+	// Tries seeds until every keyword lands in its own slot
+	static constexpr KeywordTable BuildKeywordTable()
+	{
+		for (unsigned seed = 1; seed < 1000; seed += 2)
+		{
+			KeywordTable table;
+			table.Seed = seed;
+
+			bool collided = false;
+			for (unsigned i = 0; i < sKeywordCount && !collided; i++)
+			{
+				unsigned char& slot = table.Slots[HashKeyword(sKeywords[i].Text, seed)];
+				if (slot)
+					collided = true;
+				else
+					slot = i + 1;
+			}
+
+			if (!collided)
+				return table;
+		}
+
+		return {};
+	}
+
+	static constexpr KeywordTable sKeywordTable = BuildKeywordTable();
+	static_assert(sKeywordTable.Seed, "No perfect hash seed found for the keyword table");
+
+
+	Token::Kind Facts::GetKeywordKind(std::string_view text)
+	{
+		if (text.length() < sMinKeywordLength || text.length() > sMaxKeywordLength)
+			return Token::Identifier;
+
+		unsigned char slot = sKeywordTable.Slots[HashKeyword(text, sKeywordTable.Seed)];
+		if (slot && sKeywords[slot - 1].Text == text)
+			return sKeywords[slot - 1].Kind;
+		return Token::Identifier;
+	}
+
 	unsigned Facts::GetUnaryOperatorPrecedence(Token::Kind kind)
 	{
 		switch (kind)
@@ -1,26 +1,38 @@
 #include "SympleCode/Syntax/Lexer.h"
 
-#include "SympleCode/Util/FileUtil.h"
+#include <algorithm>
 
-#define Current &Peek()
+#include "SympleCode/Syntax/Facts.h"
+#include "SympleCode/Util/Scan.h"
+#include "SympleCode/Util/ThreadPool.h"
+
+#define Current (mSource + mPosition)
 
 namespace Symple::Syntax
 {
 	Lexer::Lexer(char* file)
-		: mFile(file)
-	{
-		FILE* fs = Util::OpenFile(file, "rb");
-		if (fs)
-		{
-			mSource = Util::ReadFile(fs);
-			Util::CloseFile(fs);
-		}
-	}
+		: Lexer(file, make_shared<Util::MappedFile>(file))
+	{}
 
 	Lexer::Lexer(char* file, std::string& source)
-		: mFile(file), mSource(source)
+		: Lexer(file, make_shared<Util::MappedFile>(source))
 	{}
 
+	Lexer::Lexer(char* file, shared_ptr<Util::MappedFile> sourceFile)
+		: mFile(file), mSourceFile(sourceFile), mSource(sourceFile->GetData()), mLength(sourceFile->GetSize()),
+			mTokens(make_shared<TokenBuffer>(file, sourceFile))
+	{ mTokens->Reserve(mLength / 4); }
+
+	Lexer::Lexer(char* file, shared_ptr<Util::MappedFile> sourceFile, unsigned begin, unsigned end)
+		: mFile(file), mSourceFile(sourceFile), mSource(sourceFile->GetData()), mLength(sourceFile->GetSize()), mPosition(begin),
+			mTokens(make_shared<TokenBuffer>(file, sourceFile))
+	{ mTokens->Reserve((end - begin) / 4); }
+
+	Lexer::Lexer(Lexer& parent, unsigned begin, unsigned end)
+		: mFile(parent.mFile), mSourceFile(parent.mSourceFile), mSource(parent.mSource), mLength(parent.mLength), mPosition(begin),
+			mTokens(make_shared<TokenBuffer>(parent.mFile, parent.mSourceFile))
+	{ mTokens->Reserve((end - begin) / 4); }
+
 
 #define ATOM(char, ty) \
 	case char: \
@@ -32,32 +44,145 @@ namespace Symple::Syntax
 		char *beg = Current; \
 		for (unsigned i = 0; i < strlen(str); i++) \
 			Next(); \
-		return make_shared<Token>(Token::##ty, beg, &Next(), mTrivia, mLine, mColumn, mFile); \
+		return Push(Token::##ty, beg, Next()); \
+	}
+
+	Token Lexer::Lex()
+	{
+		LexTrivia();
+		return LexToken();
 	}
 
-	shared_ptr<Token> Lexer::Lex()
+	bool Lexer::LexParallel()
 	{
-		unsigned trKind = mPosition ? Trivia::Unknown : Trivia::StartOfLine;
-		unsigned trPosition = mPosition;
-		unsigned trLn = mLine;
-		unsigned trCl = mColumn;
+		unsigned threads = Util::ThreadPool::Get().GetThreadCount();
+		unsigned chunkCount = std::min(mLength / sParallelChunkSize, threads);
+		if (mPosition || chunkCount < 2)
+			return false;
 
-		bool checkNewLine;
-		while ((checkNewLine = CheckNewLine()) || IsWhiteSpace(Peek()))
+		// Split at the first new line after each even share of the file
+		std::vector<unsigned> bounds = { 0 };
+		for (unsigned i = 1; i < chunkCount; i++)
 		{
-			if (checkNewLine)
-				trKind |= Trivia::StartOfLine;
-			else
-				trKind |= Trivia::LeadingSpace;
+			unsigned bound = Util::ScanUntil(mSource, std::max(mLength / chunkCount * i, bounds.back()), mLength, '\n') + 1;
+			if (bound < mLength)
+				bounds.push_back(bound);
+		}
+		bounds.push_back(mLength);
 
-			Next();
+		// The first chunk is lexed straight into this lexer, the rest into their own buffers
+		std::vector<unique_ptr<Lexer>> chunks;
+		std::vector<std::future<unsigned>> jobs;
+		for (unsigned i = 1; i < bounds.size() - 1; i++)
+		{
+			chunks.push_back(unique_ptr<Lexer>(new Lexer(*this, bounds[i], bounds[i + 1])));
+			// Returns where its first token starts (a string token's text starts past that)
+			jobs.push_back(Util::ThreadPool::Get().Submit([chunk = chunks.back().get(), end = bounds[i + 1]]()
+				{
+					chunk->LexTrivia();
+					unsigned start = chunk->mPosition;
+					chunk->LexUntil(end);
+					return start;
+				}));
+		}
+		LexTrivia();
+		LexUntil(bounds[1]);
+
+		for (unsigned i = 0; i < chunks.size(); i++)
+		{
+			unsigned start = Util::ThreadPool::Get().Wait(jobs[i]);
+			Lexer& chunk = *chunks[i];
+			unsigned end = bounds[i + 2];
+			if (mTokens->GetCount() && mTokens->GetBack().Is(Token::EndOfFile))
+				break;
+
+			// A chunk only lines up if it starts on the same token this lexer stopped at.
+			// If the split landed inside a string it won't, so that chunk is lexed again here
+			if (!chunk.mTokens->GetCount() || start != mPosition)
+			{
+				LexUntil(end);
+				continue;
+			}
+
+			unsigned first = mTokens->GetCount();
+			mTokens->Append(*chunk.mTokens);
+			// Its first token's trivia started back in this chunk
+			mTokens->SetTrivia(first, mTriviaKind, mTriviaPosition, mTriviaLength);
+			for (unsigned tok = first; tok < mTokens->GetCount(); tok++)
+				if (mTokens->GetKind(tok) == Token::Unknown)
+					mDiagnosticBag->ReportUnknownToken(mTokens->Get(tok));
+
+			mPosition = chunk.mPosition;
+			mTriviaKind = chunk.mTriviaKind;
+			mTriviaPosition = chunk.mTriviaPosition;
+			mTriviaLength = chunk.mTriviaLength;
+		}
+
+		// Chunks past the end of file may still be running
+		for (auto& job : jobs)
+			if (job.valid())
+				Util::ThreadPool::Get().Wait(job);
+		return true;
+	}
+
+	bool Lexer::LexSpan(unsigned end)
+	{
+		if (end == mLength)
+		{
+			while (!Lex().Is(Token::EndOfFile));
+			return true;
+		}
+
+		while (true)
+		{
+			LexTrivia();
+			if (mPosition >= end)
+				break;
+			LexToken();
+			if (mPosition > end)
+				return false;
 		}
 
-		mTrivia = make_shared<Trivia>(trKind, &mSource[trPosition], Current, trLn, trCl, mFile);
+		bool aligned = mTriviaPosition == end;
+		mPosition = mTriviaPosition = end;
+		mTriviaKind = Trivia::Unknown;
+		mTriviaLength = 0;
+		Push(Token::EndOfFile, Current, Current);
+		return aligned;
+	}
+
+	void Lexer::LexUntil(unsigned end)
+	{
+		// The next token belongs to the following chunk, keep its trivia pending for it
+		while (mPosition < end || end == mLength)
+		{
+			if (LexToken().Is(Token::EndOfFile))
+				return;
+			LexTrivia();
+		}
+	}
+
+	void Lexer::LexTrivia()
+	{
+		mTriviaKind = mPosition ? Trivia::Unknown : Trivia::StartOfLine;
+		mTriviaPosition = mPosition;
+
+		unsigned newLines;
+		unsigned end = Util::ScanWhiteSpace(mSource, mPosition, mLength, newLines);
+		if (newLines)
+			mTriviaKind |= Trivia::StartOfLine;
+		if (end - mPosition > newLines)
+			mTriviaKind |= Trivia::LeadingSpace;
+
+		mPosition = end;
+		mTriviaLength = mPosition - mTriviaPosition;
+	}
 
+	Token Lexer::LexToken()
+	{
 		char c = Peek();
 		if (!c)
-			return LexAtom(Token::EndOfFile);
+			return Push(Token::EndOfFile, Current, Current);
 
 		if (IsNumber())
 			return LexNumber();
@@ -100,7 +225,13 @@ namespace Symple::Syntax
 
 
 	std::string_view Lexer::GetSource()
-	{ return mSource; }
+	{ return std::string_view(mSource, mLength); }
+
+	shared_ptr<Util::MappedFile> Lexer::GetSourceFile()
+	{ return mSourceFile; }
+
+	shared_ptr<TokenBuffer> Lexer::GetTokens()
+	{ return mTokens; }
 
 	char* Lexer::GetFile()
 	{ return mFile; }
@@ -132,147 +263,85 @@ namespace Symple::Syntax
 			return false;
 	}
 
-	bool Lexer::CheckNewLine()
-	{
-		if (Peek() == '\n')
-		{
-			mLine++;
-			mColumn = 0;
 
-			return true;
-		}
-		else
-			return false;
+	// The mapping has no null terminator, so reads past the end yield '\0' instead
+	char Lexer::Peek(unsigned off)
+	{
+		unsigned pos = mPosition + off;
+		if (pos >= mLength)
+			return 0;
+		return mSource[pos];
 	}
 
+	Token Lexer::Push(Token::Kind kind, char* beg, char* end, Util::Atom atom)
+	{ return mTokens->Add(kind, std::distance(mSource, beg), std::distance(beg, end), mTriviaKind, mTriviaPosition, mTriviaLength, atom); }
 
-	char& Lexer::Peek(unsigned off)
+	Util::Atom Lexer::Intern(std::string_view text)
 	{
-		unsigned pos = mPosition + off;
-		if (pos >= mSource.length())
-			return mSource[mSource.length()];
-		return mSource[pos];
+		unsigned hash = 2166136261;
+		for (char c : text)
+			hash = (hash ^ c) * 16777619;
+
+		auto& entry = mAtomCache[hash % sAtomCacheSize];
+		if (entry.first != text)
+			entry = { text, Util::Atom(text) };
+		return entry.second;
 	}
 
-	char& Lexer::Next()
+	char* Lexer::Next()
 	{
-		char& prev = mSource[mPosition];
-		mColumn++;
-		mPosition++;
-		if (mPosition > mSource.length())
-		{
-			mColumn--;
-			mPosition--;
-		}
+		char* prev = Current;
+		if (mPosition < mLength)
+			mPosition++;
 		return prev;
 	}
 
 
-	shared_ptr<Token> Lexer::LexAtom(Token::Kind kind)
-	{ return make_shared<Token>(kind, &Next(), 1, mTrivia, mLine, mColumn, mFile); }
-
-#define KEYWORD(word, key) \
-	else if (text == #word) \
-		return make_shared<Token>(Token::##key##Keyword, text, mTrivia, mLine, column, mFile)
+	Token Lexer::LexAtom(Token::Kind kind)
+	{
+		char* beg = Next();
+		return Push(kind, beg, beg + 1);
+	}
 
-	shared_ptr<Token> Lexer::LexIdentifier()
+	Token Lexer::LexIdentifier()
 	{
 		char* beg = Current;
-		unsigned column = mColumn;
 		Next();
-		while (IsIdentifier(Peek()))
-			Next();
+		mPosition = Util::ScanIdentifier(mSource, mPosition, mLength);
 
 		std::string_view text(beg, std::distance(beg, Current));
-		if (false);
-
-		KEYWORD(void, Void);
-		KEYWORD(byte, Byte);
-		KEYWORD(short, Short);
-		KEYWORD(int, Int);
-		KEYWORD(integer, Int);
-		KEYWORD(long, Long);
-
-		KEYWORD(bool, Bool);
-		KEYWORD(boolean, Bool);
-		KEYWORD(char, Char);
-		KEYWORD(wchar, WChar);
-		KEYWORD(wchar_t, WChar);
-
-		KEYWORD(float, Float);
-		KEYWORD(double, Double);
-		KEYWORD(triple, Triple);
-
-		KEYWORD(ret, Return);
-		KEYWORD(return, Return);
-
-		KEYWORD(default, Default);
-		KEYWORD(extern, Extern);
-		KEYWORD(external, Extern);
-
-		KEYWORD(link, Import);
-		KEYWORD(import, Import);
-		KEYWORD(cdecl, CDecl);
-		KEYWORD(__cdecl, CDecl);
-		KEYWORD(stdcall, StdCall);
-		KEYWORD(__stdcall, StdCall);
-
-		KEYWORD(dllimport, DllImport);
-		KEYWORD(__dllimport, DllImport);
-		KEYWORD(dllexport, DllExport);
-		KEYWORD(__dllexport, DllExport);
-
-		KEYWORD(static, Static);
-		KEYWORD(local, Local);
-		KEYWORD(private, Local);
-		KEYWORD(globl, Global);
-		KEYWORD(global, Global);
-		KEYWORD(public, Global);
-
-		KEYWORD(__asm, Native);
-		KEYWORD(native, Native);
-		KEYWORD(goto, Goto);
-
-		KEYWORD(if, If);
-		KEYWORD(else, Else);
-
-		KEYWORD(struct, Struct);
-		KEYWORD(structure, Struct);
-
-		else
-			return make_shared<Token>(Token::Identifier, text, mTrivia, mLine, column, mFile);
+		Token::Kind kind = Facts::GetKeywordKind(text);
+		if (kind == Token::Identifier)
+			return Push(kind, beg, Current, Intern(text));
+		return Push(kind, beg, Current);
 	}
 
-	shared_ptr<Token> Lexer::LexString()
+	Token Lexer::LexString()
 	{
 		Next(); // Eat "
 		char* beg = Current;
-		unsigned ln = mLine;
-		unsigned column = mColumn;
-		while (Peek() != '"')
-			Next();
+		mPosition = Util::ScanUntil(mSource, mPosition, mLength, '"');
 		char* end = Current;
 		Next();
 
-		return make_shared<Token>(Token::String, beg, end, mTrivia, ln, column, mFile);
+		return Push(Token::String, beg, end, Intern(std::string_view(beg, std::distance(beg, end))));
 	}
 
-	shared_ptr<Token> Lexer::LexNumber()
+	Token Lexer::LexNumber()
 	{
 		unsigned dotCount = 0;
 
 		char* beg = Current;
-		unsigned column = mColumn;
-		if (!IsInteger(Next()))
+		if (!IsInteger(*Next()))
 			dotCount++;
 		while (IsInteger(Peek()) || (IsNumber(Peek()) && ++dotCount))
 			Next();
 
 		if (Peek() == 'f' || Peek() == 'F')
-			return make_shared<Token>(Token::Float, beg, &Next(), mTrivia, mLine, column, mFile);
+			return Push(Token::Float, beg, Next());
 		else if (dotCount)
-			return make_shared<Token>(Token::Number, beg, Current, mTrivia, mLine, column, mFile);
+			return Push(Token::Number, beg, Current);
 		else
-			return make_shared<Token>(Token::Integer, beg, Current, mTrivia, mLine, column, mFile);
+			return Push(Token::Integer, beg, Current);
 	}
 }
\ No newline at end of file
@@ -1,50 +1,282 @@
 #include "SympleCode/Syntax/Parser.h"
 
 #include <sstream>
+#include <algorithm>
 
 #include <spdlog/spdlog.h>
 
 #include "SympleCode/Syntax/Facts.h"
 #include "SympleCode/Syntax/GlobalStatementSyntax.h"
 
+#include "SympleCode/Util/Scan.h"
+#include "SympleCode/Util/ThreadPool.h"
+
 namespace Symple::Syntax
 {
 	Parser::Parser(shared_ptr<Lexer> lexer)
+		: mTokens(lexer->GetTokens())
 	{
-		do
-			mTokens.push_back(lexer->Lex());
-		while (!mTokens.back()->Is(Token::EndOfFile));
+		mArena->KeepAlive(mTokens);
+		// Nothing left to pull if it was already lexed up front
+		if (!mTokens->GetCount() || !mTokens->GetBack().Is(Token::EndOfFile))
+			mLexer = lexer;
 	}
 
-	Parser::Parser(shared_ptr<Lexer> lexer, TokenList tokens)
+	Parser::Parser(shared_ptr<TokenBuffer> tokens)
 		: mTokens(tokens)
-	{
-		if (!tokens.empty() && tokens.back()->Is(Token::EndOfFile))
-			return;
-
-		do
-			mTokens.push_back(lexer->Lex());
-		while (!mTokens.back()->Is(Token::EndOfFile));
-	}
+	{ mArena->KeepAlive(mTokens); }
 
-	Parser::Parser(TokenList tokens)
-		: mTokens(tokens)
+	Parser::Parser(shared_ptr<TranslationUnitSyntax> previous, TextEdit edit)
+		: mPrevious(previous), mEdit(edit)
 	{}
 
+	Parser::Parser(Parser& parent, unsigned begin, std::vector<Util::Atom> structNames)
+		: mTokens(parent.mTokens), mPosition(begin), mStructNames(std::move(structNames))
+	{ mArena->KeepAlive(mTokens); }
+
 
 	shared_ptr<TranslationUnitSyntax> Parser::Parse()
 	{
+		if (mPrevious)
+			return Reparse();
+
 		std::vector<shared_ptr<MemberSyntax>> members;
-		while (!Peek()->Is(Token::EndOfFile))
+		if (!ParseParallel(members))
+			ParseMembers(members, (unsigned)-1);
+		Token eof = Match(Token::EndOfFile);
+
+		// Not from the arena, the members it holds keep that alive
+		return make_shared<TranslationUnitSyntax>(members, eof, std::vector<shared_ptr<TokenBuffer>> { mTokens }, mMemberEnds);
+	}
+
+	void Parser::ParseMembers(std::vector<shared_ptr<MemberSyntax>>& members, unsigned end)
+	{
+		while (mPosition < end && !Peek().Is(Token::EndOfFile))
 		{
 			unsigned start = mPosition;
 			members.push_back(ParseMember());
 			if (start == mPosition)
 				Next();
+			mMemberEnds.push_back(mTokens->GetTriviaOffset(Peek().GetIndex()));
+		}
+	}
+
+	bool Parser::ParseParallel(std::vector<shared_ptr<MemberSyntax>>& members)
+	{
+		// The boundaries are found ahead of time, so every token has to be there already
+		if (mLexer || mPosition)
+			return false;
+		unsigned count = mTokens->GetCount();
+		unsigned threads = Util::ThreadPool::Get().GetThreadCount();
+		unsigned chunkCount = std::min(count / sParallelChunkSize, threads);
+		if (chunkCount < 2)
+			return false;
+
+		// Split after the first member that ends past each even share, members are told apart by matching brackets.
+		// Declared structs change what parses as a type, so each chunk is given the ones before it
+		std::vector<unsigned> bounds = { 0 }, structCounts = { 0 };
+		std::vector<Util::Atom> structNames;
+		unsigned depth = 0;
+		bool memberStart = true;
+		for (unsigned i = 0; i + 2 < count && bounds.size() < chunkCount; i++)
+		{
+			Token::Kind kind = mTokens->GetKind(i);
+			if (memberStart && kind == Token::StructKeyword && mTokens->GetKind(i + 1) == Token::Identifier)
+				structNames.push_back(mTokens->GetAtom(i + 1));
+
+			memberStart = false;
+			switch (kind)
+			{
+			case Token::OpenParenthesis:
+			case Token::OpenBrace:
+				depth++;
+				break;
+			case Token::CloseParenthesis:
+				if (depth)
+					depth--;
+				break;
+			case Token::CloseBrace:
+				if (depth)
+					depth--;
+				memberStart = !depth;
+				break;
+			case Token::Semicolon:
+				memberStart = !depth;
+				break;
+			}
+
+			if (memberStart && i + 1 >= count / chunkCount * bounds.size())
+			{
+				bounds.push_back(i + 1);
+				structCounts.push_back(structNames.size());
+			}
+		}
+		bounds.push_back(count);
+
+		// The first chunk is parsed here, the rest by their own parsers into their own arenas
+		std::vector<unique_ptr<Parser>> chunks;
+		std::vector<std::future<std::vector<shared_ptr<MemberSyntax>>>> jobs;
+		for (unsigned i = 1; i < bounds.size() - 1; i++)
+		{
+			std::vector<Util::Atom> names(structNames.begin(), structNames.begin() + structCounts[i]);
+			chunks.push_back(unique_ptr<Parser>(new Parser(*this, bounds[i], std::move(names))));
+			jobs.push_back(Util::ThreadPool::Get().Submit([chunk = chunks.back().get(), end = bounds[i + 1]]()
+				{
+					std::vector<shared_ptr<MemberSyntax>> chunkMembers;
+					chunk->ParseMembers(chunkMembers, end);
+					return chunkMembers;
+				}));
+		}
+		ParseMembers(members, bounds[1]);
+
+		for (unsigned i = 0; i < chunks.size(); i++)
+		{
+			auto chunkMembers = Util::ThreadPool::Get().Wait(jobs[i]);
+			Parser& chunk = *chunks[i];
+			if (Peek().Is(Token::EndOfFile))
+				break;
+
+			// A chunk only lines up if the last member parsed here ended where it starts, with the same structs declared.
+			// If a member didn't end where the brackets said it would, that chunk is parsed again here
+			unsigned structCount = structCounts[i + 1];
+			if (mPosition != bounds[i + 1] || mStructNames.size() != structCount ||
+				!std::equal(mStructNames.begin(), mStructNames.end(), structNames.begin()))
+			{
+				ParseMembers(members, bounds[i + 2]);
+				continue;
+			}
+
+			members.insert(members.end(), chunkMembers.begin(), chunkMembers.end());
+			mDiagnosticBag->Append(*chunk.mDiagnosticBag);
+			mMemberEnds.insert(mMemberEnds.end(), chunk.mMemberEnds.begin(), chunk.mMemberEnds.end());
+			mStructNames = chunk.mStructNames;
+			mPosition = chunk.mPosition;
+		}
+
+		// Chunks past the end of file may still be running
+		for (auto& job : jobs)
+			if (job.valid())
+				Util::ThreadPool::Get().Wait(job);
+		return true;
+	}
+
+	shared_ptr<TranslationUnitSyntax> Parser::Reparse()
+	{
+		std::vector<shared_ptr<TokenBuffer>>& previousTokens = mPrevious->GetTokens();
+		auto previousSource = previousTokens.front()->GetSourceFile();
+		std::string_view previousText = previousSource->GetText();
+
+		std::string text;
+		text.reserve(previousText.length() - mEdit.Length + mEdit.Text.length());
+		text.append(previousText.substr(0, mEdit.Offset)).append(mEdit.Text).append(previousText.substr(mEdit.Offset + mEdit.Length));
+		auto source = make_shared<Util::MappedFile>(text);
+		int delta = (int)mEdit.Text.length() - (int)mEdit.Length;
+
+		std::vector<shared_ptr<MemberSyntax>> previousMembers = mPrevious->GetMembers();
+		std::vector<unsigned>& previousEnds = mPrevious->GetMemberEnds();
+		unsigned count = previousMembers.size();
+
+		// Every member the edit touches is parsed again, along with the one before in case the edit runs into it
+		unsigned first = std::lower_bound(previousEnds.begin(), previousEnds.end(), mEdit.Offset) - previousEnds.begin();
+		if (first)
+			first--;
+		unsigned last = std::upper_bound(previousEnds.begin(), previousEnds.end(), mEdit.Offset + mEdit.Length) - previousEnds.begin();
+		// Reused tokens are shifted on every edit, once some have been through too many everything is parsed again into one buffer
+		for (auto& buffer : previousTokens)
+			if (buffer->GetShiftCount() >= sMaxShifts)
+			{
+				first = 0;
+				last = count;
+			}
+		unsigned begin = first ? previousEnds[first - 1] : 0;
+
+		// An if at the end could now take an else that started the next member
+		while (last < count)
+		{
+			unsigned newLines;
+			unsigned next = Util::ScanWhiteSpace(previousSource->GetData(), previousEnds[last], previousText.length(), newLines);
+			if (previousText.substr(next, 4) != "else" || (next + 4 < previousText.length() && Lexer::IsIdentifier(previousText[next + 4])))
+				break;
+			last++;
+		}
+
+		// Declared structs change what parses as a type, the reparsed members have to declare the same ones
+		std::vector<Util::Atom> structNames, previousStructNames;
+		for (unsigned i = 0; i < std::min(last + 1, count); i++)
+			if (previousMembers[i]->GetKind() == Node::StructDeclaration)
+			{
+				Util::Atom name = dynamic_pointer_cast<StructDeclarationSyntax>(previousMembers[i])->GetName().GetAtom();
+				if (i < first)
+					structNames.push_back(name);
+				previousStructNames.push_back(name);
+			}
+
+		// If the members don't end where they used to, everything up to the end of file is parsed again
+		std::vector<shared_ptr<MemberSyntax>> members;
+		while (true)
+		{
+			bool toEnd = last >= count;
+			unsigned end = toEnd ? source->GetSize() : previousEnds[last] + delta;
+
+			members.clear();
+			mMemberEnds.clear();
+			mArena = make_shared<Util::Arena>();
+
+			Lexer lexer(previousTokens.front()->GetFile(), source, begin, end);
+			bool aligned = lexer.LexSpan(end);
+			mTokens = lexer.GetTokens();
+			mArena->KeepAlive(mTokens);
+			mPosition = 0;
+			mStructNames = structNames;
+			mDiagnosticBag = make_shared<DiagnosticBag>();
+			mDiagnosticBag->Append(*lexer.GetDiagnosticBag());
+			if (aligned)
+				ParseMembers(members, (unsigned)-1);
+
+			if (toEnd)
+				break;
+
+			bool reachedEnd = false;
+			for (auto diagnostic : mDiagnosticBag->GetDiagnostics())
+				if (diagnostic->GetToken().GetBuffer() == mTokens.get() && diagnostic->GetToken().GetIndex() == mTokens->GetCount() - 1)
+					reachedEnd = true;
+			if (aligned && !reachedEnd && mStructNames == previousStructNames)
+				break;
+			last = count;
 		}
-		shared_ptr<Token> eof = Match(Token::EndOfFile);
 
-		return make_shared<TranslationUnitSyntax>(members, eof);
+		Token eof = last < count ? mPrevious->GetToken() : mTokens->GetBack();
+
+		// Only the buffers of reused members are kept, whatever follows the edit moves along with it
+		std::vector<TokenBuffer*> memberTokens, used = { eof.GetBuffer() };
+		for (unsigned i = 0; i < count; i++)
+			if (i < first || i > last)
+				used.push_back(mPrevious->GetMemberTokens(i));
+		std::vector<shared_ptr<TokenBuffer>> tokens;
+		unsigned previousEnd = last < count ? previousEnds[last] : previousText.length();
+		for (unsigned i = 0; i < previousTokens.size(); i++)
+			if (std::find(used.begin(), used.end(), previousTokens[i].get()) != used.end())
+			{
+				previousTokens[i]->Rebase(source, previousEnd, delta);
+				tokens.push_back(previousTokens[i]);
+			}
+		tokens.push_back(mTokens);
+
+		for (unsigned i = 0; i < first; i++)
+			memberTokens.push_back(mPrevious->GetMemberTokens(i));
+		memberTokens.insert(memberTokens.end(), members.size(), mTokens.get());
+		members.insert(members.begin(), previousMembers.begin(), previousMembers.begin() + first);
+		std::vector<unsigned> memberEnds(previousEnds.begin(), previousEnds.begin() + first);
+		memberEnds.insert(memberEnds.end(), mMemberEnds.begin(), mMemberEnds.end());
+		for (unsigned i = last + 1; i < count; i++)
+		{
+			members.push_back(previousMembers[i]);
+			memberEnds.push_back(previousEnds[i] + delta);
+			memberTokens.push_back(mPrevious->GetMemberTokens(i));
+		}
+
+		mPrevious = nullptr;
+		return make_shared<TranslationUnitSyntax>(members, eof, tokens, memberEnds, memberTokens);
 	}
 
 
@@ -53,7 +285,7 @@ namespace Symple::Syntax
 		if (IsType())
 			return ParseFunctionDeclaration();
 		else
-			switch (Peek()->GetKind())
+			switch (Peek().GetKind())
 			{
 			case Token::ExternKeyword:
 				return ParseExternFunction();
@@ -62,39 +294,39 @@ namespace Symple::Syntax
 			case Token::ImportKeyword:
 				return ParseImportStatement();
 			default:
-				return make_shared<GlobalStatementSyntax>(ParseStatement());
+				return Make<GlobalStatementSyntax>(ParseStatement());
 			}
 	}
 
 	shared_ptr<ExternFunctionSyntax> Parser::ParseExternFunction()
 	{
-		shared_ptr<Token> keyword = Match(Token::ExternKeyword);
+		Token keyword = Match(Token::ExternKeyword);
 		auto type = ParseType();
-		shared_ptr<Token> name = Match(Token::Identifier);
-		shared_ptr<Token> openParen = Match(Token::OpenParenthesis);
+		Token name = Match(Token::Identifier);
+		Token openParen = Match(Token::OpenParenthesis);
 		auto params = ParseFunctionParameters();
-		shared_ptr<Token> closeParen = Match(Token::CloseParenthesis);
+		Token closeParen = Match(Token::CloseParenthesis);
 		TokenList modifiers = ParseFunctionModifiers();
 		Match(Token::Semicolon);
 
-		return make_shared<ExternFunctionSyntax>(keyword, type, name, openParen, params, closeParen, modifiers);
+		return Make<ExternFunctionSyntax>(keyword, type, name, openParen, MakeList(params), closeParen, Util::ArenaArray<Token>(*mArena, modifiers));
 	}
 
 	shared_ptr<FunctionDeclarationSyntax> Parser::ParseFunctionDeclaration()
 	{
 		auto type = ParseType();
-		shared_ptr<Token> name = Match(Token::Identifier);
-		shared_ptr<Token> openParen = Match(Token::OpenParenthesis);
+		Token name = Match(Token::Identifier);
+		Token openParen = Match(Token::OpenParenthesis);
 		auto params = ParseFunctionParameters();
-		shared_ptr<Token> closeParen = Match(Token::CloseParenthesis);
+		Token closeParen = Match(Token::CloseParenthesis);
 		TokenList modifiers = ParseFunctionModifiers();
 
-		if (Peek()->Is(Token::EqualArrow))
+		if (Peek().Is(Token::EqualArrow))
 			Next();
 
 		shared_ptr<StatementSyntax> statement = ParseStatement();
 
-		return make_shared<FunctionDeclarationSyntax>(type, name, openParen, params, closeParen, modifiers, statement);
+		return Make<FunctionDeclarationSyntax>(type, name, openParen, MakeList(params), closeParen, Util::ArenaArray<Token>(*mArena, modifiers), statement);
 	}
 
 	VariableDeclarationList Parser::ParseFunctionParameters()
@@ -103,9 +335,9 @@ namespace Symple::Syntax
 
 		bool first = true;
 		shared_ptr<TypeSyntax> pty;
-		while (!Peek()->Is(Token::CloseParenthesis))
+		while (!Peek().Is(Token::CloseParenthesis))
 		{
-			if (Peek()->Is(Token::EndOfFile))
+			if (Peek().Is(Token::EndOfFile))
 			{
 				mDiagnosticBag->ReportUnexpectedEndOfFile(Peek());
 				break;
@@ -116,7 +348,7 @@ namespace Symple::Syntax
 			else
 				Match(Token::Comma);
 
-			if (!Peek()->Is(Token::CloseParenthesis))
+			if (!Peek().Is(Token::CloseParenthesis))
 			{
 				list.push_back(ParseVariableDeclaration(pty));
 				pty = list.back()->GetType();
@@ -130,12 +362,12 @@ namespace Symple::Syntax
 	{
 		TokenList list;
 
-		while (Peek()->Is(Token::CDeclKeyword, Token::StdCallKeyword,           // Naming Conventions
+		while (Peek().Is(Token::CDeclKeyword, Token::StdCallKeyword,           // Naming Conventions
 			Token::DllExportKeyword, Token::DllImportKeyword,                   // Dll Stuff
 			Token::StaticKeyword, Token::LocalKeyword, Token::GlobalKeyword,    // Visibility Modifiers
 			Token::Comma))                                                      // Commas
 		{
-			if (Peek()->Is(Token::Comma))
+			if (Peek().Is(Token::Comma))
 				Next();
 			else
 				list.push_back(Next());
@@ -146,14 +378,14 @@ namespace Symple::Syntax
 
 	shared_ptr<StructDeclarationSyntax> Parser::ParseStructDeclaration()
 	{
-		shared_ptr<Token> keyword = Match(Token::StructKeyword);
-		shared_ptr<Token> name = Match(Token::Identifier);
-		shared_ptr<Token> open = Match(Token::OpenBrace);
+		Token keyword = Match(Token::StructKeyword);
+		Token name = Match(Token::Identifier);
+		Token open = Match(Token::OpenBrace);
 		auto members = ParseStructMembers();
-		shared_ptr<Token> close = Match(Token::CloseBrace);
+		Token close = Match(Token::CloseBrace);
 
-		mStructNames.push_back(std::string(name->GetText()));
-		return make_shared<StructDeclarationSyntax>(keyword, name, open, members, close);
+		mStructNames.push_back(name.GetAtom());
+		return Make<StructDeclarationSyntax>(keyword, name, open, MakeList(members), close);
 	}
 
 	VariableDeclarationList Parser::ParseStructMembers()
@@ -162,9 +394,9 @@ namespace Symple::Syntax
 
 		bool first = true;
 		shared_ptr<TypeSyntax> pty;
-		while (!Peek()->Is(Token::CloseBrace))
+		while (!Peek().Is(Token::CloseBrace))
 		{
-			if (Peek()->Is(Token::EndOfFile))
+			if (Peek().Is(Token::EndOfFile))
 			{
 				mDiagnosticBag->ReportUnexpectedEndOfFile(Peek());
 				break;
@@ -175,7 +407,7 @@ namespace Symple::Syntax
 			else
 				Match(Token::Comma);
 
-			if (!Peek()->Is(Token::CloseBrace))
+			if (!Peek().Is(Token::CloseBrace))
 			{
 				list.push_back(ParseVariableDeclaration(pty));
 				pty = list.back()->GetType();
@@ -187,11 +419,11 @@ namespace Symple::Syntax
 
 	shared_ptr<ImportStatementSyntax> Parser::ParseImportStatement()
 	{
-		shared_ptr<Token> tok = Match(Token::ImportKeyword);
-		shared_ptr<Token> import = Match(Token::String);
+		Token tok = Match(Token::ImportKeyword);
+		Token import = Match(Token::String);
 		Match(Token::Semicolon);
 
-		return make_shared<ImportStatementSyntax>(tok, import);
+		return Make<ImportStatementSyntax>(tok, import);
 	}
 
 
@@ -202,7 +434,7 @@ namespace Symple::Syntax
 		if (IsType())
 			statement = ParseVariableDeclaration();
 		else
-			switch (Peek()->GetKind())
+			switch (Peek().GetKind())
 			{
 			case Token::IfKeyword:
 				statement = ParseIfStatement();
@@ -222,7 +454,7 @@ namespace Symple::Syntax
 				statement = ParseReturnStatement();
 				break;
 			case Token::Identifier:
-				if (Peek(1)->Is(Token::Colon))
+				if (Peek(1).Is(Token::Colon))
 				{
 					statement = ParseLabel();
 					matchSemi = false;
@@ -241,56 +473,56 @@ namespace Symple::Syntax
 
 	shared_ptr<LabelSyntax> Parser::ParseLabel()
 	{
-		shared_ptr<Token> label = Match(Token::Identifier);
-		shared_ptr<Token> colon = Match(Token::Colon);
+		Token label = Match(Token::Identifier);
+		Token colon = Match(Token::Colon);
 
-		return make_shared<LabelSyntax>(label, colon);
+		return Make<LabelSyntax>(label, colon);
 	}
 
 	shared_ptr<IfStatementSyntax> Parser::ParseIfStatement()
 	{
-		shared_ptr<Token> ifKey = Match(Token::IfKeyword);
+		Token ifKey = Match(Token::IfKeyword);
 		shared_ptr<ParenthesizedExpressionSyntax> cond = ParseParenthesizedExpression();
 		shared_ptr<StatementSyntax> then = ParseStatement();
 
-		shared_ptr<Token> elseKey;
+		Token elseKey;
 		shared_ptr<StatementSyntax> elze;
-		if (Peek()->Is(Token::ElseKeyword))
+		if (Peek().Is(Token::ElseKeyword))
 		{
 			elseKey = Next();
 			elze = ParseStatement();
 		}
 
-		return make_shared<IfStatementSyntax>(ifKey, cond, then, elseKey, elze);
+		return Make<IfStatementSyntax>(ifKey, cond, then, elseKey, elze);
 	}
 
 	shared_ptr<GotoStatementSyntax> Parser::ParseGotoStatement()
 	{
-		shared_ptr<Token> keyword = Match(Token::GotoKeyword);
-		shared_ptr<Token> label = Match(Token::Identifier);
+		Token keyword = Match(Token::GotoKeyword);
+		Token label = Match(Token::Identifier);
 
-		return make_shared<GotoStatementSyntax>(keyword, label);
+		return Make<GotoStatementSyntax>(keyword, label);
 	}
 
 	shared_ptr<NativeStatementSyntax> Parser::ParseNativeStatement()
 	{
-		shared_ptr<Token> tok = Match(Token::NativeKeyword);
-		shared_ptr<Token> code = Match(Token::String);
+		Token tok = Match(Token::NativeKeyword);
+		Token code = Match(Token::String);
 
-		return make_shared<NativeStatementSyntax>(tok, code);
+		return Make<NativeStatementSyntax>(tok, code);
 	}
 
 	shared_ptr<BlockStatementSyntax> Parser::ParseBlockStatement()
 	{
-		shared_ptr<Token> open = Match(Token::OpenBrace);
+		Token open = Match(Token::OpenBrace);
 		std::vector<shared_ptr<StatementSyntax>> statements;
 
-		while (!Peek()->Is(Token::CloseBrace))
+		while (!Peek().Is(Token::CloseBrace))
 		{
-			if (Peek()->Is(Token::EndOfFile))
+			if (Peek().Is(Token::EndOfFile))
 			{
 				mDiagnosticBag->ReportUnexpectedEndOfFile(Peek());
-				return make_shared<BlockStatementSyntax>(open, statements, Peek());
+				return Make<BlockStatementSyntax>(open, MakeList(statements), Peek());
 			}
 
 			unsigned start = mPosition;
@@ -301,49 +533,49 @@ namespace Symple::Syntax
 				Next();
 		}
 
-		shared_ptr<Token> close = Match(Token::CloseBrace);
+		Token close = Match(Token::CloseBrace);
 
-		return make_shared<BlockStatementSyntax>(open, statements, close);
+		return Make<BlockStatementSyntax>(open, MakeList(statements), close);
 	}
 
 	shared_ptr<ReturnStatementSyntax> Parser::ParseReturnStatement()
 	{
-		shared_ptr<Token> tok = Match(Token::ReturnKeyword);
+		Token tok = Match(Token::ReturnKeyword);
 		shared_ptr<ExpressionSyntax> val = ParseExpression();
 
-		return make_shared<ReturnStatementSyntax>(tok, val);
+		return Make<ReturnStatementSyntax>(tok, val);
 	}
 
 	shared_ptr<ExpressionStatementSyntax> Parser::ParseExpressionStatement()
 	{
 		shared_ptr<ExpressionSyntax> expr = ParseExpression();
 
-		return make_shared<ExpressionStatementSyntax>(expr);
+		return Make<ExpressionStatementSyntax>(expr);
 	}
 
 	shared_ptr<VariableDeclarationSyntax> Parser::ParseVariableDeclaration(shared_ptr<TypeSyntax> ty)
 	{
 		if (!ty || IsType())
 			ty = ParseType();
-		shared_ptr<Token> name = Token::Default;
-		if (Peek()->Is(Token::Identifier))
+		Token name = Token::Default;
+		if (Peek().Is(Token::Identifier))
 			name = Next();
 
-		shared_ptr<Token> equals = Token::Default;
+		Token equals = Token::Default;
 		shared_ptr<ExpressionSyntax> initializer;
-		if (Peek()->Is(Token::Equal))
+		if (Peek().Is(Token::Equal))
 		{
 			equals = Next();
 			initializer = ParseExpression();
 		}
 
-		return make_shared<VariableDeclarationSyntax>(ty, name, equals, initializer);
+		return Make<VariableDeclarationSyntax>(ty, name, equals, initializer);
 	}
 
 	shared_ptr<TypeSyntax> Parser::ParseType(shared_ptr<TypeSyntax> base)
 	{
-		shared_ptr<Token> tyqename = Next();
-		base = make_shared<TypeReferenceSyntax>(tyqename, base);
+		Token tyqename = Next();
+		base = Make<TypeReferenceSyntax>(tyqename, base);
 		if (IsType())
 			return ParseType(base);
 		else
@@ -354,105 +586,158 @@ namespace Symple::Syntax
 	shared_ptr<ExpressionSyntax> Parser::ParseExpression()
 	{ return ParseBinaryExpression(); }
 
-	ExpressionList Parser::ParseExpressionList()
+	shared_ptr<ExpressionSyntax> Parser::ParseUnaryExpression(unsigned parentPrecedence)
+	{ return ParseExpressionFrames(parentPrecedence, false); }
+
+	shared_ptr<ExpressionSyntax> Parser::ParseBinaryExpression(unsigned parentPrecedence)
+	{ return ParseExpressionFrames(parentPrecedence, true); }
+
+	// Precedence climbing without recursion, every unary operator, parenthesis and call pushes a frame
+	// that the finished operand is handed back to, so nesting depth only grows mExpressionFrames
+	shared_ptr<ExpressionSyntax> Parser::ParseExpressionFrames(unsigned parentPrecedence, bool binary)
 	{
-		ExpressionList list;
+		unsigned base = mExpressionFrames.size();
+		if (binary)
+			mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Binary, parentPrecedence));
 
-		bool first = true;
-		while (!Peek()->Is(Token::CloseParenthesis, Token::CloseBrace))
+		unsigned precedence = parentPrecedence;
+		shared_ptr<ExpressionSyntax> operand;
+		while (true)
 		{
-			if (Peek()->Is(Token::EndOfFile))
+			// Descend to the next primary expression
+			while (!operand)
 			{
-				mDiagnosticBag->ReportUnexpectedEndOfFile(Peek());
-				break;
+				unsigned unaryPrecedence = Facts::GetUnaryOperatorPrecedence(Peek().GetKind());
+				if (unaryPrecedence && unaryPrecedence <= precedence)
+				{
+					mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Unary, 0, Next()));
+					mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Binary, unaryPrecedence));
+					precedence = unaryPrecedence;
+				}
+				else if (Peek().Is(Token::OpenParenthesis))
+				{
+					mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Parenthesized, 0, Match(Token::OpenParenthesis)));
+					mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Binary));
+					precedence = 0;
+				}
+				else if (Peek().Is(Token::Identifier) && Peek(1).Is(Token::OpenParenthesis))
+				{
+					Token name = Match(Token::Identifier);
+					mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Call, 0, name, Match(Token::OpenParenthesis)));
+					if (ParseNextArgument(true))
+						precedence = 0;
+					else
+					{
+						ExpressionFrame& call = mExpressionFrames.back();
+						operand = Make<CallExpressionSyntax>(call.Start, call.Open, MakeList(call.Arguments), Match(Token::CloseParenthesis));
+						mExpressionFrames.pop_back();
+					}
+				}
+				else
+					operand = ParsePrimaryExpression();
 			}
 
-			if (first)
-				first = false;
-			else
-				Match(Token::Comma);
-			list.push_back(ParseExpression());
-		}
-
-		return list;
-	}
+			// Hand the operand back up until a frame needs another one
+			while (operand)
+			{
+				if (mExpressionFrames.size() == base)
+					return operand;
 
-	shared_ptr<ExpressionSyntax> Parser::ParseUnaryExpression(unsigned parentPrecedence)
-	{
-		unsigned precedence = Facts::GetUnaryOperatorPrecedence(Peek()->GetKind());
-		if (precedence && precedence <= parentPrecedence)
-		{
-			shared_ptr<Token> oqerator = Next();
-			shared_ptr<ExpressionSyntax> operand = ParseBinaryExpression(precedence);
-			return make_shared<UnaryExpressionSyntax>(oqerator, operand);
+				ExpressionFrame& frame = mExpressionFrames.back();
+				switch (frame.Kind)
+				{
+				case ExpressionFrame::Binary:
+					if (frame.Left)
+						frame.Left = Make<BinaryExpressionSyntax>(frame.Start, frame.Left, operand);
+					else
+						frame.Left = operand;
+
+					precedence = Facts::GetBinaryOperatorPrecedence(Peek().GetKind());
+					if (!precedence || (frame.Precedence && precedence >= frame.Precedence))
+					{
+						operand = frame.Left;
+						mExpressionFrames.pop_back();
+					}
+					else
+					{
+						frame.Start = Next();
+						operand = nullptr;
+					}
+					break;
+				case ExpressionFrame::Unary:
+					operand = Make<UnaryExpressionSyntax>(frame.Start, operand);
+					mExpressionFrames.pop_back();
+					break;
+				case ExpressionFrame::Parenthesized:
+					operand = Make<ParenthesizedExpressionSyntax>(frame.Start, operand, Match(Token::CloseParenthesis));
+					mExpressionFrames.pop_back();
+					break;
+				case ExpressionFrame::Call:
+					frame.Arguments.push_back(operand);
+					if (ParseNextArgument(false))
+					{
+						precedence = 0;
+						operand = nullptr;
+					}
+					else
+					{
+						operand = Make<CallExpressionSyntax>(frame.Start, frame.Open, MakeList(frame.Arguments), Match(Token::CloseParenthesis));
+						mExpressionFrames.pop_back();
+					}
+					break;
+				}
+			}
 		}
-		else
-			return ParsePrimaryExpression();
 	}
 
-	shared_ptr<ExpressionSyntax> Parser::ParseBinaryExpression(unsigned parentPrecedence)
+	bool Parser::ParseNextArgument(bool first)
 	{
-		shared_ptr<ExpressionSyntax> left = ParseUnaryExpression(parentPrecedence);
-
-		while (true)
+		if (Peek().Is(Token::CloseParenthesis, Token::CloseBrace))
+			return false;
+		if (Peek().Is(Token::EndOfFile))
 		{
-			unsigned precedence = Facts::GetBinaryOperatorPrecedence(Peek()->GetKind());
-			if (!precedence || parentPrecedence && precedence >= parentPrecedence)
-				return left;
-
-			shared_ptr<Token> oqerator = Next();
-			shared_ptr<ExpressionSyntax> right = ParseUnaryExpression(precedence);
-			left = make_shared<BinaryExpressionSyntax>(oqerator, left, right);
+			mDiagnosticBag->ReportUnexpectedEndOfFile(Peek());
+			return false;
 		}
+
+		if (!first)
+			Match(Token::Comma);
+		mExpressionFrames.push_back(ExpressionFrame(ExpressionFrame::Binary));
+		return true;
 	}
 
 
 	shared_ptr<ExpressionSyntax> Parser::ParsePrimaryExpression()
 	{
-		switch (Peek()->GetKind())
+		switch (Peek().GetKind())
 		{
 		case Token::Identifier:
-			if (Peek(1)->Is(Token::OpenParenthesis))
-				return ParseCallExpression();
-			else
-				return ParseNameExpression();
+			return ParseNameExpression();
 		case Token::Number:
 		case Token::Float:
 		case Token::Integer:
 		case Token::String:
 		case Token::DefaultKeyword:
 			return ParseLiteralExpression();
-		case Token::OpenParenthesis:
-			return ParseParenthesizedExpression();
 
 		default:
-			return make_shared<ExpressionSyntax>(Next());
+			return Make<ExpressionSyntax>(Next());
 		}
 	}
 
 	shared_ptr<NameExpressionSyntax> Parser::ParseNameExpression()
-	{ return make_shared<NameExpressionSyntax>(Match(Token::Identifier)); }
-
-	shared_ptr<CallExpressionSyntax> Parser::ParseCallExpression()
-	{
-		shared_ptr<Token> name = Match(Token::Identifier);
-		shared_ptr<Token> open = Match(Token::OpenParenthesis);
-		ExpressionList args = ParseExpressionList();
-		shared_ptr<Token> close = Match(Token::CloseParenthesis);
-
-		return make_shared<CallExpressionSyntax>(name, open, args, close);
-	}
+	{ return Make<NameExpressionSyntax>(Match(Token::Identifier)); }
 
 	shared_ptr<LiteralExpressionSyntax> Parser::ParseLiteralExpression()
-	{ return make_shared<LiteralExpressionSyntax>(Next()); }
+	{ return Make<LiteralExpressionSyntax>(Next()); }
 
 	shared_ptr<ParenthesizedExpressionSyntax> Parser::ParseParenthesizedExpression()
 	{
-		shared_ptr<Token> open = Match(Token::OpenParenthesis);
+		Token open = Match(Token::OpenParenthesis);
 		shared_ptr<ExpressionSyntax> expression = ParseExpression();
-		shared_ptr<Token> close = Match(Token::CloseParenthesis);
+		Token close = Match(Token::CloseParenthesis);
 
-		return make_shared<ParenthesizedExpressionSyntax>(open, expression, close);
+		return Make<ParenthesizedExpressionSyntax>(open, expression, close);
 	}
 
 	
@@ -460,24 +745,28 @@ namespace Symple::Syntax
 	{ return mDiagnosticBag; }
 
 
-	shared_ptr<Token> Parser::Peek(unsigned off)
+	Token Parser::Peek(unsigned off)
 	{
 		unsigned pos = mPosition + off;
-		if (pos >= mTokens.size())
-			return mTokens.back();
-		return mTokens[pos];
+		// Pull just enough from the lexer to cover the lookahead
+		while (mLexer && pos >= mTokens->GetCount())
+			if (mLexer->Lex().Is(Token::EndOfFile))
+				mLexer = nullptr;
+		if (pos >= mTokens->GetCount())
+			return mTokens->GetBack();
+		return mTokens->Get(pos);
 	}
 
-	shared_ptr<Token> Parser::Next()
+	Token Parser::Next()
 	{
 		auto current = Peek();
 		mPosition++;
 		return current;
 	}
 
-	shared_ptr<Token> Parser::Match(Token::Kind kind)
+	Token Parser::Match(Token::Kind kind)
 	{
-		if (Peek()->Is(kind))
+		if (Peek().Is(kind))
 			return Next();
 
 		mDiagnosticBag->ReportUnexpectedToken(Peek(), kind);
@@ -487,7 +776,7 @@ namespace Symple::Syntax
 
 	bool Parser::IsType()
 	{
-		switch (Peek()->GetKind())
+		switch (Peek().GetKind())
 		{
 		case Token::VoidKeyword:
 		case Token::ByteKeyword:
@@ -508,7 +797,7 @@ namespace Symple::Syntax
 
 		case Token::Identifier:
 			for (auto name : mStructNames)
-				if (Peek()->GetText() == name)
+				if (Peek().GetAtom() == name)
 					return true;
 
 		default:
@@ -1,4 +1,5 @@
 #include "SympleCode/Syntax/Token.h"
+#include "SympleCode/Syntax/TokenBuffer.h"
 
 #include <spdlog/spdlog.h>
 
@@ -6,62 +7,67 @@
 
 namespace Symple::Syntax
 {
-	__SYC_API shared_ptr<Token> Token::Error = make_shared<Token>();
-	__SYC_API shared_ptr<Token> Token::Default = make_shared<Token>();
+	__SYC_API Token Token::Error;
+	__SYC_API Token Token::Default;
 
 
-	Token::Token(Kind kind, shared_ptr<Trivia> trivia, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(), mTrivia(trivia), mLine(ln), mColumn(col), mFile(file)
-	{}
-
-	Token::Token(Kind kind, std::string_view text, shared_ptr<Trivia> trivia, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(text), mTrivia(trivia), mLine(ln), mColumn(col), mFile(file)
-	{}
-
-	Token::Token(Kind kind, char* beg, unsigned len, shared_ptr<Trivia> trivia, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(beg, len), mTrivia(trivia), mLine(ln), mColumn(col), mFile(file)
-	{}
-
-	Token::Token(Kind kind, char* beg, char* end, shared_ptr<Trivia> trivia, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(beg, std::distance(beg, end)), mTrivia(trivia), mLine(ln), mColumn(col), mFile(file)
+	Token::Token(TokenBuffer* buffer, unsigned index)
+		: mBuffer(buffer), mIndex(index)
 	{}
 
 
 	bool Token::IsKeyword()
-	{ return mKind >= FirstKeyword; }
+	{ return GetKind() >= FirstKeyword; }
 
 	bool Token::Is(Kind kind)
-	{ return mKind == kind; }
+	{ return GetKind() == kind; }
 
 
 	void Token::Print(std::ostream& os, std::string_view indent, bool last, std::string_view label)
 	{
 		Node::PrintIndent(os, indent, last, label);
 		os << KindMap[GetKind()] << "Token '" << GetText() << "' ";
-		GetTrivia()->PrintShort(os);
+		GetTrivia().PrintShort(os);
 		os << " <" << GetLine() << ':' << GetColumn() << ">";
 	}
 
 	void Token::PrintShort(std::ostream& os)
-	{ os << '(' << KindMap[mKind] << ") " << mText; }
+	{ os << '(' << KindMap[GetKind()] << ") " << GetText(); }
 
 
 	Token::Kind Token::GetKind()
-	{ return mKind; }
+	{ return mBuffer ? mBuffer->GetKind(mIndex) : Unknown; }
 
 	std::string_view Token::GetText()
-	{ return mText; }
+	{ return mBuffer ? mBuffer->GetText(mIndex) : std::string_view(); }
+
+	Util::Atom Token::GetAtom()
+	{ return mBuffer ? mBuffer->GetAtom(mIndex) : Util::Atom(); }
 
-	shared_ptr<Trivia> Token::GetTrivia()
-	{ return mTrivia; }
+	Trivia Token::GetTrivia()
+	{ return mBuffer ? mBuffer->GetTrivia(mIndex) : Trivia::None; }
 
 
-	char* Token::GetFile()
-	{ return mFile; }
+	const char* Token::GetFile()
+	{ return mBuffer ? mBuffer->GetFile() : "<NA>"; }
 
 	unsigned Token::GetLine()
-	{ return mLine; }
+	{ return mBuffer ? mBuffer->GetLine(mIndex) : 0; }
 
 	unsigned Token::GetColumn()
-	{ return mColumn; }
+	{ return mBuffer ? mBuffer->GetColumn(mIndex) : 0; }
+
+
+	TokenBuffer* Token::GetBuffer()
+	{ return mBuffer; }
+
+	unsigned Token::GetIndex()
+	{ return mIndex; }
+
+
+	bool Token::operator ==(const Token& other) const
+	{ return mBuffer == other.mBuffer && mIndex == other.mIndex; }
+
+	bool Token::operator !=(const Token& other) const
+	{ return !(*this == other); }
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "SympleCode/Syntax/TokenBuffer.h"
+
+#include <algorithm>
+
+namespace Symple::Syntax
+{
+	TokenBuffer::TokenBuffer(char* file, shared_ptr<Util::MappedFile> sourceFile)
+		: mSourceFile(sourceFile), mFile(file)
+	{}
+
+
+	Token TokenBuffer::Add(Token::Kind kind, unsigned offset, unsigned length, Trivia::Kind trKind, unsigned trOffset, unsigned trLength, Util::Atom atom)
+	{
+		mKinds.push_back(kind);
+		mOffsets.push_back(offset);
+		mLengths.push_back(length);
+		mTriviaKinds.push_back(trKind);
+		mTriviaOffsets.push_back(trOffset);
+		mTriviaLengths.push_back(trLength);
+		mAtoms.push_back(atom.GetId());
+
+		return Token(this, mKinds.size() - 1);
+	}
+
+	void TokenBuffer::Append(TokenBuffer& other)
+	{
+		mKinds.insert(mKinds.end(), other.mKinds.begin(), other.mKinds.end());
+		mOffsets.insert(mOffsets.end(), other.mOffsets.begin(), other.mOffsets.end());
+		mLengths.insert(mLengths.end(), other.mLengths.begin(), other.mLengths.end());
+		mTriviaKinds.insert(mTriviaKinds.end(), other.mTriviaKinds.begin(), other.mTriviaKinds.end());
+		mTriviaOffsets.insert(mTriviaOffsets.end(), other.mTriviaOffsets.begin(), other.mTriviaOffsets.end());
+		mTriviaLengths.insert(mTriviaLengths.end(), other.mTriviaLengths.begin(), other.mTriviaLengths.end());
+		mAtoms.insert(mAtoms.end(), other.mAtoms.begin(), other.mAtoms.end());
+	}
+
+	void TokenBuffer::SetTrivia(unsigned index, Trivia::Kind kind, unsigned offset, unsigned length)
+	{
+		mTriviaKinds[index] = kind;
+		mTriviaOffsets[index] = offset;
+		mTriviaLengths[index] = length;
+	}
+
+	void TokenBuffer::Reserve(unsigned count)
+	{
+		mKinds.reserve(count);
+		mOffsets.reserve(count);
+		mLengths.reserve(count);
+		mTriviaKinds.reserve(count);
+		mTriviaOffsets.reserve(count);
+		mTriviaLengths.reserve(count);
+		mAtoms.reserve(count);
+	}
+
+	void TokenBuffer::Rebase(shared_ptr<Util::MappedFile> sourceFile, unsigned from, int delta)
+	{
+		mEditedFile = sourceFile;
+		mShifts.push_back({ from, delta });
+	}
+
+	unsigned TokenBuffer::GetShiftCount()
+	{ return mShifts.size(); }
+
+
+	Token TokenBuffer::Get(unsigned index)
+	{ return Token(this, index); }
+
+	Token TokenBuffer::GetBack()
+	{ return Token(this, mKinds.size() - 1); }
+
+	unsigned TokenBuffer::GetCount()
+	{ return mKinds.size(); }
+
+
+	Token::Kind TokenBuffer::GetKind(unsigned index)
+	{ return (Token::Kind)mKinds[index]; }
+
+	std::string_view TokenBuffer::GetText(unsigned index)
+	{ return std::string_view(mSourceFile->GetData() + mOffsets[index], mLengths[index]); }
+
+	Trivia TokenBuffer::GetTrivia(unsigned index)
+	{
+		Trivia::Kind kind = mTriviaKinds[index];
+		std::string_view text(mSourceFile->GetData() + mTriviaOffsets[index], mTriviaLengths[index]);
+
+		if (kind == Trivia::Unknown && text.empty())
+			return Trivia::None;
+		else if (kind == Trivia::LeadingSpace && text == " ")
+			return Trivia::Space;
+		else
+			return Trivia(kind, text);
+	}
+
+	unsigned TokenBuffer::GetOffset(unsigned index)
+	{ return Shift(mOffsets[index]); }
+
+	unsigned TokenBuffer::GetTriviaOffset(unsigned index)
+	{ return Shift(mTriviaOffsets[index]); }
+
+	Util::Atom TokenBuffer::GetAtom(unsigned index)
+	{ return Util::Atom::FromId(mAtoms[index]); }
+
+	unsigned TokenBuffer::GetLine(unsigned index)
+	{
+		// Index of the last line start at or before the token
+		auto& lineStarts = GetSourceFile()->GetLineStarts();
+		return std::distance(lineStarts.begin(), std::upper_bound(lineStarts.begin(), lineStarts.end(), GetOffset(index)));
+	}
+
+	unsigned TokenBuffer::GetColumn(unsigned index)
+	{ return GetOffset(index) - GetSourceFile()->GetLineStarts()[GetLine(index) - 1] + 1; }
+
+
+	char* TokenBuffer::GetFile()
+	{ return mFile.data(); }
+
+	shared_ptr<Util::MappedFile> TokenBuffer::GetSourceFile()
+	{ return mEditedFile ? mEditedFile : mSourceFile; }
+
+
+	unsigned TokenBuffer::Shift(unsigned offset)
+	{
+		for (auto& [from, delta] : mShifts)
+			if (offset >= from)
+				offset += delta;
+		return offset;
+	}
+}
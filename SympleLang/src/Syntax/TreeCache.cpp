@@ -0,0 +1,612 @@
+#include "SympleCode/Syntax/TreeCache.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "SympleCode/Syntax/ExternFunctionSyntax.h"
+#include "SympleCode/Syntax/FunctionDeclarationSyntax.h"
+#include "SympleCode/Syntax/StructDeclarationSyntax.h"
+#include "SympleCode/Syntax/GlobalStatementSyntax.h"
+
+#include "SympleCode/Syntax/TypeReferenceSyntax.h"
+#include "SympleCode/Syntax/ImportStatementSyntax.h"
+#include "SympleCode/Syntax/NativeStatementSyntax.h"
+
+#include "SympleCode/Syntax/LabelSyntax.h"
+#include "SympleCode/Syntax/IfStatementSyntax.h"
+#include "SympleCode/Syntax/GotoStatementSyntax.h"
+#include "SympleCode/Syntax/BlockStatementSyntax.h"
+#include "SympleCode/Syntax/ReturnStatementSyntax.h"
+#include "SympleCode/Syntax/ExpressionStatementSyntax.h"
+#include "SympleCode/Syntax/VariableDeclarationSyntax.h"
+
+#include "SympleCode/Syntax/UnaryExpressionSyntax.h"
+#include "SympleCode/Syntax/BinaryExpressionSyntax.h"
+#include "SympleCode/Syntax/LiteralExpressionSyntax.h"
+#include "SympleCode/Syntax/ParenthesizedExpressionSyntax.h"
+#include "SympleCode/Syntax/NameExpressionSyntax.h"
+#include "SympleCode/Syntax/CallExpressionSyntax.h"
+
+namespace Symple::Syntax
+{
+	// Magic, version, source size, source hash and the hash of everything after the header
+	static constexpr unsigned sHeaderSize = 4 + sizeof(unsigned) * 2 + sizeof(uint64_t) * 2;
+
+	shared_ptr<TranslationUnitSyntax> TreeCache::Load(char* path, char* file, shared_ptr<Util::MappedFile> source)
+	{
+		FILE* fs;
+		if (fopen_s(&fs, path, "rb") || !fs)
+			return nullptr;
+
+		// Not ReadFile, that stops at the first null
+		TreeCache cache;
+		fseek(fs, 0, SEEK_END);
+		long size = ftell(fs);
+		if (size < 0)
+		{
+			Util::CloseFile(fs);
+			return nullptr;
+		}
+		cache.mData.resize(size);
+		rewind(fs);
+		cache.mData.resize(fread(cache.mData.data(), 1, cache.mData.length(), fs));
+		Util::CloseFile(fs);
+
+		if (cache.mData.length() < sHeaderSize || memcmp(cache.mData.data(), sMagic, sizeof(sMagic)))
+			return nullptr;
+		cache.mPosition = sizeof(sMagic);
+		if (cache.Read<unsigned>() != sVersion || cache.Read<unsigned>() != source->GetSize() || cache.Read<uint64_t>() != Hash(source->GetText()) ||
+			cache.Read<uint64_t>() != Hash(std::string_view(cache.mData).substr(sHeaderSize)))
+			return nullptr;
+
+		auto tokens = make_shared<TokenBuffer>(file, source);
+		unsigned count = cache.Read<unsigned>();
+		tokens->Reserve(std::min(count, source->GetSize() + 1));
+		for (unsigned i = 0; i < count && !cache.mFailed; i++)
+		{
+			auto kind = (Token::Kind)cache.Read<unsigned char>();
+			auto triviaKind = (Trivia::Kind)cache.Read<unsigned char>();
+			unsigned offset = cache.Read<unsigned>(), length = cache.Read<unsigned>();
+			unsigned triviaOffset = cache.Read<unsigned>(), triviaLength = cache.Read<unsigned>();
+			if (kind > Token::Last || offset > source->GetSize() || length > source->GetSize() - offset ||
+				triviaOffset > source->GetSize() || triviaLength > source->GetSize() - triviaOffset)
+			{
+				cache.mFailed = true;
+				break;
+			}
+
+			// Atoms are only valid in the process that made them
+			Util::Atom atom;
+			if (kind == Token::Identifier || kind == Token::String)
+				atom = Util::Atom(source->GetText().substr(offset, length));
+			tokens->Add(kind, offset, length, triviaKind, triviaOffset, triviaLength, atom);
+		}
+
+		if (cache.mFailed || !tokens->GetCount() || !tokens->GetBack().Is(Token::EndOfFile))
+			return nullptr;
+		return cache.ReadTree(tokens);
+	}
+
+	bool TreeCache::Store(char* path, shared_ptr<TranslationUnitSyntax> unit)
+	{
+		if (unit->GetTokens().size() != 1)
+			return false;
+
+		TreeCache cache;
+		auto tokens = unit->GetTokens().front();
+		cache.mTokens = tokens.get();
+		auto source = tokens->GetSourceFile();
+
+		cache.Write<unsigned>(tokens->GetCount());
+		for (unsigned i = 0; i < tokens->GetCount(); i++)
+		{
+			Trivia trivia = tokens->GetTrivia(i);
+			cache.Write<unsigned char>(tokens->GetKind(i));
+			cache.Write<unsigned char>(trivia.GetKind());
+			cache.Write<unsigned>(tokens->GetOffset(i));
+			cache.Write<unsigned>(tokens->GetText(i).length());
+			cache.Write<unsigned>(tokens->GetTriviaOffset(i));
+			cache.Write<unsigned>(trivia.GetText().length());
+		}
+		cache.WriteTree(unit);
+		if (cache.mFailed)
+			return false;
+
+		std::string header(sMagic, sizeof(sMagic));
+		header.append((char*)&sVersion, sizeof(sVersion));
+		unsigned size = source->GetSize();
+		header.append((char*)&size, sizeof(size));
+		uint64_t hash = Hash(source->GetText());
+		header.append((char*)&hash, sizeof(hash));
+		hash = Hash(cache.mData);
+		header.append((char*)&hash, sizeof(hash));
+
+		FILE* fs = Util::OpenFile(path, "wb");
+		if (!fs)
+			return false;
+		bool written = fwrite(header.data(), 1, header.length(), fs) == header.length() &&
+			fwrite(cache.mData.data(), 1, cache.mData.length(), fs) == cache.mData.length();
+		Util::CloseFile(fs);
+		return written;
+	}
+
+	uint64_t TreeCache::Hash(std::string_view data)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : data)
+			hash = (hash ^ (unsigned char)c) * 1099511628211ull;
+		return hash;
+	}
+
+
+	template<typename T>
+	void TreeCache::Write(T value)
+	{ mData.append((char*)&value, sizeof(T)); }
+
+	void TreeCache::Write(Token tok)
+	{ Write<unsigned>(tok.GetBuffer() == mTokens ? tok.GetIndex() : -1); }
+
+	void TreeCache::WriteTree(shared_ptr<TranslationUnitSyntax> unit)
+	{
+		// Written children first, so the reader builds every node out of the ones just before it without recursing
+		std::vector<std::pair<shared_ptr<Node>, bool>> stack;
+		auto members = unit->GetMembers();
+		for (auto member = members.rbegin(); member != members.rend(); member++)
+			stack.push_back({ *member, false });
+
+		while (!stack.empty() && !mFailed)
+		{
+			auto [node, expanded] = stack.back();
+			stack.pop_back();
+
+			if (!node)
+				Write<unsigned char>(sNull);
+			else if (expanded)
+				WriteNode(node);
+			else
+			{
+				stack.push_back({ node, true });
+				std::vector<shared_ptr<Node>> children;
+				GetChildren(node, children);
+				for (auto child = children.rbegin(); child != children.rend(); child++)
+					stack.push_back({ *child, false });
+			}
+		}
+
+		Write<unsigned char>(Node::TranslationUnit);
+		Write<unsigned>(members.size());
+		Write(unit->GetToken());
+		for (unsigned end : unit->GetMemberEnds())
+			Write<unsigned>(end);
+	}
+
+	void TreeCache::GetChildren(shared_ptr<Node> node, std::vector<shared_ptr<Node>>& children)
+	{
+		switch (node->GetKind())
+		{
+		case Node::FunctionDeclaration:
+		{
+			auto function = dynamic_pointer_cast<FunctionDeclarationSyntax>(node);
+			children.push_back(function->GetType());
+			for (auto param : function->GetParameters())
+				children.push_back(param);
+			children.push_back(function->GetBody());
+			break;
+		}
+		case Node::ExternFunction:
+		{
+			auto function = dynamic_pointer_cast<ExternFunctionSyntax>(node);
+			children.push_back(function->GetType());
+			for (auto param : function->GetParameters())
+				children.push_back(param);
+			break;
+		}
+		case Node::StructDeclaration:
+			for (auto member : dynamic_pointer_cast<StructDeclarationSyntax>(node)->GetMembers())
+				children.push_back(member);
+			break;
+		case Node::GlobalStatement:
+			children.push_back(dynamic_pointer_cast<GlobalStatementSyntax>(node)->GetStatement());
+			break;
+
+		case Node::TypeReference:
+			children.push_back(dynamic_pointer_cast<TypeReferenceSyntax>(node)->GetBase());
+			break;
+		case Node::VariableDeclaration:
+		{
+			auto variable = dynamic_pointer_cast<VariableDeclarationSyntax>(node);
+			children.push_back(variable->GetType());
+			children.push_back(variable->GetInitializer());
+			break;
+		}
+		case Node::IfStatement:
+		{
+			auto ifStatement = dynamic_pointer_cast<IfStatementSyntax>(node);
+			children.push_back(ifStatement->GetCondition());
+			children.push_back(ifStatement->GetThen());
+			children.push_back(ifStatement->GetElse());
+			break;
+		}
+		case Node::BlockStatement:
+			for (auto statement : dynamic_pointer_cast<BlockStatementSyntax>(node)->GetStatements())
+				children.push_back(statement);
+			break;
+		case Node::ReturnStatement:
+			children.push_back(dynamic_pointer_cast<ReturnStatementSyntax>(node)->GetValue());
+			break;
+		case Node::ExpressionStatement:
+			children.push_back(dynamic_pointer_cast<ExpressionStatementSyntax>(node)->GetExpression());
+			break;
+
+		case Node::UnaryExpression:
+			children.push_back(dynamic_pointer_cast<UnaryExpressionSyntax>(node)->GetOperand());
+			break;
+		case Node::BinaryExpression:
+		{
+			auto binary = dynamic_pointer_cast<BinaryExpressionSyntax>(node);
+			children.push_back(binary->GetLeft());
+			children.push_back(binary->GetRight());
+			break;
+		}
+		case Node::ParenthesizedExpression:
+			children.push_back(dynamic_pointer_cast<ParenthesizedExpressionSyntax>(node)->GetExpression());
+			break;
+		case Node::CallExpression:
+			for (auto arg : dynamic_pointer_cast<CallExpressionSyntax>(node)->GetArguments())
+				children.push_back(arg);
+			break;
+
+		// Leaves
+		default:
+			break;
+		}
+	}
+
+	void TreeCache::WriteNode(shared_ptr<Node> node)
+	{
+		Write<unsigned char>(node->GetKind());
+		switch (node->GetKind())
+		{
+		case Node::FunctionDeclaration:
+		{
+			auto function = dynamic_pointer_cast<FunctionDeclarationSyntax>(node);
+			Write(function->GetName());
+			Write(function->GetOpenParenthesis());
+			Write(function->GetCloseParenthesis());
+			Write<unsigned>(function->GetParameters().size());
+			Write<unsigned>(function->GetModifiers().size());
+			for (auto modifier : function->GetModifiers())
+				Write(modifier);
+			break;
+		}
+		case Node::ExternFunction:
+		{
+			auto function = dynamic_pointer_cast<ExternFunctionSyntax>(node);
+			Write(function->GetKeyword());
+			Write(function->GetName());
+			Write(function->GetOpenParenthesis());
+			Write(function->GetCloseParenthesis());
+			Write<unsigned>(function->GetParameters().size());
+			Write<unsigned>(function->GetModifiers().size());
+			for (auto modifier : function->GetModifiers())
+				Write(modifier);
+			break;
+		}
+		case Node::StructDeclaration:
+		{
+			auto structure = dynamic_pointer_cast<StructDeclarationSyntax>(node);
+			Write(structure->GetKeyword());
+			Write(structure->GetName());
+			Write(structure->GetOpenBrace());
+			Write(structure->GetCloseBrace());
+			Write<unsigned>(structure->GetMembers().size());
+			break;
+		}
+		case Node::ImportStatement:
+		{
+			auto import = dynamic_pointer_cast<ImportStatementSyntax>(node);
+			Write(import->GetKeyword());
+			Write(import->GetImport());
+			break;
+		}
+		case Node::GlobalStatement:
+		case Node::ExpressionStatement:
+			break;
+
+		case Node::VariableDeclaration:
+			Write(node->GetToken());
+			Write(dynamic_pointer_cast<VariableDeclarationSyntax>(node)->GetEquals());
+			break;
+		case Node::Label:
+			Write(node->GetToken());
+			Write(dynamic_pointer_cast<LabelSyntax>(node)->GetColon());
+			break;
+		case Node::IfStatement:
+			Write(node->GetToken());
+			Write(dynamic_pointer_cast<IfStatementSyntax>(node)->GetElseKeyword());
+			break;
+		case Node::GotoStatement:
+			Write(dynamic_pointer_cast<GotoStatementSyntax>(node)->GetKeyword());
+			Write(node->GetToken());
+			break;
+		case Node::NativeStatement:
+			Write(node->GetToken());
+			Write(dynamic_pointer_cast<NativeStatementSyntax>(node)->GetAssembly());
+			break;
+		case Node::BlockStatement:
+		{
+			auto block = dynamic_pointer_cast<BlockStatementSyntax>(node);
+			Write(block->GetOpen());
+			Write(block->GetClose());
+			Write<unsigned>(block->GetStatements().size());
+			break;
+		}
+		case Node::ParenthesizedExpression:
+			Write(node->GetToken());
+			Write(dynamic_pointer_cast<ParenthesizedExpressionSyntax>(node)->GetClose());
+			break;
+		case Node::CallExpression:
+		{
+			auto call = dynamic_pointer_cast<CallExpressionSyntax>(node);
+			Write(call->GetName());
+			Write(call->GetOpenParenthesis());
+			Write(call->GetCloseParenthesis());
+			Write<unsigned>(call->GetArguments().size());
+			break;
+		}
+
+		case Node::TypeReference:
+		case Node::ReturnStatement:
+		case Node::Expression:
+		case Node::UnaryExpression:
+		case Node::BinaryExpression:
+		case Node::LiteralExpression:
+		case Node::NameExpression:
+			Write(node->GetToken());
+			break;
+
+		default:
+			// Nothing the parser makes
+			mFailed = true;
+			break;
+		}
+	}
+
+
+	template<typename T>
+	T TreeCache::Read()
+	{
+		T value = {};
+		if (mPosition + sizeof(T) > mData.length())
+			mFailed = true;
+		else
+		{
+			memcpy(&value, mData.data() + mPosition, sizeof(T));
+			mPosition += sizeof(T);
+		}
+		return value;
+	}
+
+	Token TreeCache::ReadToken()
+	{
+		unsigned index = Read<unsigned>();
+		if (index == (unsigned)-1)
+			return Token();
+		if (index >= mTokens->GetCount())
+		{
+			mFailed = true;
+			return Token();
+		}
+		return mTokens->Get(index);
+	}
+
+	shared_ptr<TranslationUnitSyntax> TreeCache::ReadTree(shared_ptr<TokenBuffer> tokens)
+	{
+		mTokens = tokens.get();
+		mArena = make_shared<Util::Arena>();
+		mArena->KeepAlive(tokens);
+
+		while (!mFailed)
+		{
+			auto kind = (Node::Kind)Read<unsigned char>();
+			if (kind == Node::TranslationUnit)
+				break;
+			else if (kind == sNull)
+				mNodes.push_back(nullptr);
+			else
+				mNodes.push_back(ReadNode(kind));
+		}
+
+		unsigned count = Read<unsigned>();
+		Token eof = ReadToken();
+		if (mFailed || count != mNodes.size())
+			return nullptr;
+		std::vector<shared_ptr<MemberSyntax>> members = PopList<MemberSyntax>(count);
+		std::vector<unsigned> memberEnds(count);
+		for (unsigned& end : memberEnds)
+			end = Read<unsigned>();
+		if (mFailed || mPosition != mData.length())
+			return nullptr;
+
+		return make_shared<TranslationUnitSyntax>(members, eof, std::vector<shared_ptr<TokenBuffer>> { tokens }, memberEnds);
+	}
+
+	shared_ptr<Node> TreeCache::ReadNode(Node::Kind kind)
+	{
+		switch (kind)
+		{
+		case Node::FunctionDeclaration:
+		{
+			Token name = ReadToken(), open = ReadToken(), close = ReadToken();
+			unsigned paramCount = Read<unsigned>(), modifierCount = Read<unsigned>();
+			TokenList modifiers;
+			for (unsigned i = 0; i < modifierCount && !mFailed; i++)
+				modifiers.push_back(ReadToken());
+
+			auto body = Pop<StatementSyntax>();
+			auto params = PopList<VariableDeclarationSyntax>(paramCount);
+			auto type = Pop<TypeSyntax>();
+			return Make<FunctionDeclarationSyntax>(type, name, open, Node::MakeList(*mArena, params), close, Util::ArenaArray<Token>(*mArena, modifiers), body);
+		}
+		case Node::ExternFunction:
+		{
+			Token keyword = ReadToken(), name = ReadToken(), open = ReadToken(), close = ReadToken();
+			unsigned paramCount = Read<unsigned>(), modifierCount = Read<unsigned>();
+			TokenList modifiers;
+			for (unsigned i = 0; i < modifierCount && !mFailed; i++)
+				modifiers.push_back(ReadToken());
+
+			auto params = PopList<VariableDeclarationSyntax>(paramCount);
+			auto type = Pop<TypeSyntax>();
+			return Make<ExternFunctionSyntax>(keyword, type, name, open, Node::MakeList(*mArena, params), close, Util::ArenaArray<Token>(*mArena, modifiers));
+		}
+		case Node::StructDeclaration:
+		{
+			Token keyword = ReadToken(), name = ReadToken(), open = ReadToken(), close = ReadToken();
+			auto members = PopList<VariableDeclarationSyntax>(Read<unsigned>());
+			return Make<StructDeclarationSyntax>(keyword, name, open, Node::MakeList(*mArena, members), close);
+		}
+		case Node::ImportStatement:
+		{
+			Token keyword = ReadToken(), import = ReadToken();
+			return Make<ImportStatementSyntax>(keyword, import);
+		}
+		case Node::GlobalStatement:
+		{
+			auto statement = Pop<StatementSyntax>();
+			return statement ? Make<GlobalStatementSyntax>(statement) : nullptr;
+		}
+
+		case Node::TypeReference:
+		{
+			Token name = ReadToken();
+			return Make<TypeReferenceSyntax>(name, Pop<TypeSyntax>(true));
+		}
+		case Node::VariableDeclaration:
+		{
+			Token name = ReadToken(), equals = ReadToken();
+			auto initializer = Pop<ExpressionSyntax>(true);
+			auto type = Pop<TypeSyntax>();
+			return Make<VariableDeclarationSyntax>(type, name, equals, initializer);
+		}
+		case Node::Label:
+		{
+			Token label = ReadToken(), colon = ReadToken();
+			return Make<LabelSyntax>(label, colon);
+		}
+		case Node::IfStatement:
+		{
+			Token ifKeyword = ReadToken(), elseKeyword = ReadToken();
+			auto elze = Pop<StatementSyntax>(true);
+			auto then = Pop<StatementSyntax>();
+			auto condition = Pop<ParenthesizedExpressionSyntax>();
+			return Make<IfStatementSyntax>(ifKeyword, condition, then, elseKeyword, elze);
+		}
+		case Node::GotoStatement:
+		{
+			Token keyword = ReadToken(), label = ReadToken();
+			return Make<GotoStatementSyntax>(keyword, label);
+		}
+		case Node::NativeStatement:
+		{
+			Token keyword = ReadToken(), code = ReadToken();
+			return Make<NativeStatementSyntax>(keyword, code);
+		}
+		case Node::BlockStatement:
+		{
+			Token open = ReadToken(), close = ReadToken();
+			auto statements = PopList<StatementSyntax>(Read<unsigned>());
+			return Make<BlockStatementSyntax>(open, Node::MakeList(*mArena, statements), close);
+		}
+		case Node::ReturnStatement:
+		{
+			Token keyword = ReadToken();
+			return Make<ReturnStatementSyntax>(keyword, Pop<ExpressionSyntax>(true));
+		}
+		case Node::ExpressionStatement:
+		{
+			auto expression = Pop<ExpressionSyntax>();
+			return expression ? Make<ExpressionStatementSyntax>(expression) : nullptr;
+		}
+
+		case Node::Expression:
+			return Make<ExpressionSyntax>(ReadToken());
+		case Node::LiteralExpression:
+			return Make<LiteralExpressionSyntax>(ReadToken());
+		case Node::NameExpression:
+			return Make<NameExpressionSyntax>(ReadToken());
+		case Node::UnaryExpression:
+		{
+			Token oqerator = ReadToken();
+			return Make<UnaryExpressionSyntax>(oqerator, Pop<ExpressionSyntax>());
+		}
+		case Node::BinaryExpression:
+		{
+			Token oqerator = ReadToken();
+			auto right = Pop<ExpressionSyntax>();
+			auto left = Pop<ExpressionSyntax>();
+			return Make<BinaryExpressionSyntax>(oqerator, left, right);
+		}
+		case Node::ParenthesizedExpression:
+		{
+			Token open = ReadToken(), close = ReadToken();
+			return Make<ParenthesizedExpressionSyntax>(open, Pop<ExpressionSyntax>(), close);
+		}
+		case Node::CallExpression:
+		{
+			Token name = ReadToken(), open = ReadToken(), close = ReadToken();
+			return Make<CallExpressionSyntax>(name, open, Node::MakeList(*mArena, PopList<ExpressionSyntax>(Read<unsigned>())), close);
+		}
+
+		default:
+			mFailed = true;
+			return nullptr;
+		}
+	}
+
+	template<typename T>
+	shared_ptr<T> TreeCache::Pop(bool optional)
+	{
+		if (mNodes.empty())
+		{
+			mFailed = true;
+			return nullptr;
+		}
+
+		auto node = mNodes.back();
+		mNodes.pop_back();
+		auto result = dynamic_pointer_cast<T>(node);
+		if (node ? !result : !optional)
+			mFailed = true;
+		return result;
+	}
+
+	template<typename T>
+	std::vector<shared_ptr<T>> TreeCache::PopList(unsigned count)
+	{
+		std::vector<shared_ptr<T>> list;
+		if (count > mNodes.size())
+		{
+			mFailed = true;
+			return list;
+		}
+
+		for (unsigned i = mNodes.size() - count; i < mNodes.size(); i++)
+		{
+			list.push_back(dynamic_pointer_cast<T>(mNodes[i]));
+			if (!list.back())
+				mFailed = true;
+		}
+		mNodes.resize(mNodes.size() - count);
+		return list;
+	}
+
+	template<typename T, typename... Args>
+	shared_ptr<T> TreeCache::Make(Args&&... args)
+	{
+		// Anything read after a failure is thrown away, and might not be whole
+		if (mFailed)
+			return nullptr;
+		return Node::Make<T>(mArena, std::forward<Args>(args)...);
+	}
+}
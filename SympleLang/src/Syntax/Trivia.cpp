@@ -4,24 +4,12 @@
 
 namespace Symple::Syntax
 {
-	__SYC_API shared_ptr<Trivia> Trivia::Error = make_shared<Trivia>();
-	__SYC_API shared_ptr<Trivia> Trivia::Default = make_shared<Trivia>();
+	__SYC_API const Trivia Trivia::None;
+	__SYC_API const Trivia Trivia::Space(LeadingSpace, " ");
 
 
-	Trivia::Trivia(Kind kind, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(), mLine(ln), mColumn(col), mFile(file)
-	{}
-
-	Trivia::Trivia(Kind kind, std::string_view text, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(text), mLine(ln), mColumn(col), mFile(file)
-	{}
-
-	Trivia::Trivia(Kind kind, char* beg, unsigned len, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(beg, len), mLine(ln), mColumn(col), mFile(file)
-	{}
-
-	Trivia::Trivia(Kind kind, char* beg, char* end, unsigned ln, unsigned col, char* file)
-		: mKind(kind), mText(beg, std::distance(beg, end)), mLine(ln), mColumn(col), mFile(file)
+	Trivia::Trivia(Kind kind, std::string_view text)
+		: mKind(kind), mText(text)
 	{}
 
 
@@ -36,7 +24,7 @@ namespace Symple::Syntax
 			if (Is(KindArray[k]))
 				os << '[' << KindMap[KindArray[k]] << "] ";
 
-		os << "Trivia '" << GetText() << "' <" << GetLine() << ':' << GetColumn() << ">";
+		os << "Trivia '" << GetText() << "'";
 	}
 
 	void Trivia::PrintShort(std::ostream& os)
@@ -52,14 +40,4 @@ namespace Symple::Syntax
 
 	std::string_view Trivia::GetText()
 	{ return mText; }
-
-
-	char* Trivia::GetFile()
-	{ return mFile; }
-
-	unsigned Trivia::GetLine()
-	{ return mLine; }
-
-	unsigned Trivia::GetColumn()
-	{ return mColumn; }
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "SympleCode/Util/Arena.h"
+
+namespace Symple::Util
+{
+	Arena::~Arena()
+	{
+		for (char* block : mBlocks)
+			delete[] block;
+	}
+
+
+	void* Arena::AllocateBlock(size_t size, size_t align)
+	{
+		// Anything too big to share a block gets one to itself, so the current block keeps its space
+		if (size + align > sBlockSize / 4)
+		{
+			char* block = new char[size + align];
+			mBlocks.push_back(block);
+			mAllocatedBytes += size;
+			return (char*)(((size_t)block + align - 1) & ~(align - 1));
+		}
+
+		mCurrent = new char[sBlockSize];
+		mEnd = mCurrent + sBlockSize;
+		mBlocks.push_back(mCurrent);
+		return Allocate(size, align);
+	}
+}
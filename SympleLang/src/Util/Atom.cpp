@@ -0,0 +1,66 @@
+#include "SympleCode/Util/Atom.h"
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Symple::Util
+{
+	// Split by hash so threads lexing different chunks rarely wait on each other.
+	// An id is the index within its shard followed by the shard number
+	static constexpr unsigned sShardBits = 4;
+
+	struct AtomShard
+	{
+		std::mutex mMutex;
+		std::deque<std::string> mTexts; // Never moves its elements
+		std::unordered_map<std::string_view, unsigned> mIds;
+	};
+
+	static AtomShard* GetShards()
+	{
+		static AtomShard sShards[1 << sShardBits];
+		static std::once_flag sEmptyFlag;
+		// Id 0 is always the empty string
+		std::call_once(sEmptyFlag, []()
+			{
+				sShards[0].mTexts.emplace_back();
+				sShards[0].mIds.emplace(sShards[0].mTexts.back(), 0);
+			});
+		return sShards;
+	}
+
+	Atom::Atom(std::string_view text)
+	{
+		size_t hash = std::hash<std::string_view>()(text);
+		unsigned shardIndex = text.empty() ? 0 : hash & ((1 << sShardBits) - 1);
+		AtomShard& shard = GetShards()[shardIndex];
+
+		std::lock_guard<std::mutex> lock(shard.mMutex);
+		auto found = shard.mIds.find(text);
+		if (found != shard.mIds.end())
+		{
+			mId = found->second;
+			return;
+		}
+
+		mId = (shard.mTexts.size() << sShardBits) | shardIndex;
+		shard.mTexts.emplace_back(text);
+		shard.mIds.emplace(shard.mTexts.back(), mId);
+	}
+
+	std::string_view Atom::GetText() const
+	{
+		AtomShard& shard = GetShards()[mId & ((1 << sShardBits) - 1)];
+		std::lock_guard<std::mutex> lock(shard.mMutex);
+		return shard.mTexts[mId >> sShardBits];
+	}
+
+	Atom Atom::FromId(unsigned id)
+	{
+		Atom atom;
+		atom.mId = id;
+		return atom;
+	}
+}
@@ -1,12 +1,15 @@
 #include "SympleCode/Util/ConsoleColor.h"
 
+#include <atomic>
+
 #if _WIN32
 #include <Windows.h>
 #endif
 
 namespace Symple::Util
 {
-	static ConsoleColor sConsoleColor;
+	// Imports log from the thread pool
+	static std::atomic<ConsoleColor> sConsoleColor;
 
 	void SetConsoleColor(ConsoleColor c)
 	{
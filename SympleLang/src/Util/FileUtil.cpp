@@ -2,6 +2,18 @@
 
 #include <spdlog/spdlog.h>
 
+#include "SympleCode/Util/Scan.h"
+
+#if _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace Symple::Util
 {
 	FILE* OpenFile(char* path, char* perms)
@@ -71,4 +83,97 @@ namespace Symple::Util
 
 		return str;
 	}
+
+
+	MappedFile::MappedFile(char* path)
+		: mData(mBuffer.data())
+	{
+#if _WIN32
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			spdlog::error("Error opening file '{}'", path);
+			return;
+		}
+
+		mFileHandle = file;
+		mSize = GetFileSize(file, nullptr);
+		if (!mSize) // Can't map an empty file
+			return;
+
+		mMappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mMappingHandle)
+			mData = (char*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+		if (!mMappingHandle || !mData)
+		{
+			spdlog::error("Error mapping file '{}'", path);
+			mData = mBuffer.data();
+			mSize = 0;
+		}
+#else
+		int fd = open(path, O_RDONLY);
+		if (fd == -1)
+		{
+			spdlog::error("Error opening file '{}': {}", path, strerror(errno));
+			return;
+		}
+
+		struct stat st;
+		if (!fstat(fd, &st) && st.st_size)
+		{
+			void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data == MAP_FAILED)
+				spdlog::error("Error mapping file '{}': {}", path, strerror(errno));
+			else
+			{
+				mData = (char*)data;
+				mSize = st.st_size;
+				mMapped = true;
+			}
+		}
+		close(fd); // The mapping keeps its own reference to the file
+#endif
+	}
+
+	MappedFile::MappedFile(std::string_view text)
+		: mBuffer(text), mData(mBuffer.data()), mSize(mBuffer.length())
+	{}
+
+	MappedFile::~MappedFile()
+	{
+#if _WIN32
+		if (mData != mBuffer.data())
+			UnmapViewOfFile(mData);
+		if (mMappingHandle)
+			CloseHandle(mMappingHandle);
+		if (mFileHandle)
+			CloseHandle(mFileHandle);
+#else
+		if (mMapped)
+			munmap(mData, mSize);
+#endif
+	}
+
+
+	bool MappedFile::IsMapped()
+	{ return mData != mBuffer.data(); }
+
+	char* MappedFile::GetData()
+	{ return mData; }
+
+	unsigned MappedFile::GetSize()
+	{ return mSize; }
+
+	std::string_view MappedFile::GetText()
+	{ return std::string_view(mData, mSize); }
+
+	std::vector<unsigned>& MappedFile::GetLineStarts()
+	{
+		std::call_once(mLineStartsFlag, [this]()
+			{
+				mLineStarts.push_back(0);
+				ScanLineStarts(mData, mSize, mLineStarts);
+			});
+		return mLineStarts;
+	}
 }
\ No newline at end of file
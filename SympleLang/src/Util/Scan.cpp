@@ -0,0 +1,353 @@
+#include "SympleCode/Util/Scan.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define __SY_SCAN_SIMD 1
+#if _MSC_VER
+#include <intrin.h>
+#define __SY_SCAN_TARGET(isa)
+#else
+#include <immintrin.h>
+#define __SY_SCAN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#else
+#define __SY_SCAN_SIMD 0
+#endif
+
+namespace Symple::Util
+{
+	static ScanLevel DetectScanLevel()
+	{
+#if __SY_SCAN_SIMD
+#if _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		bool sse2 = info[3] & (1 << 26);
+		// AVX state also has to be enabled by the OS
+		bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+		bool avx2 = false;
+		if (avx && maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			avx2 = info[1] & (1 << 5);
+		}
+#else
+		__builtin_cpu_init();
+		bool sse2 = __builtin_cpu_supports("sse2");
+		bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+		if (avx2)
+			return AVX2Scan;
+		else if (sse2)
+			return SSE2Scan;
+#endif
+		return ScalarScan;
+	}
+
+	// Zero initialized (scalar) until the dynamic initializer runs
+	static ScanLevel sScanLevel = GetSupportedScanLevel();
+
+	ScanLevel GetSupportedScanLevel()
+	{
+		static ScanLevel supported = DetectScanLevel();
+		return supported;
+	}
+
+	ScanLevel GetScanLevel()
+	{ return sScanLevel; }
+
+	void SetScanLevel(ScanLevel level)
+	{ sScanLevel = level > GetSupportedScanLevel() ? GetSupportedScanLevel() : level; }
+
+	char* GetScanLevelName(ScanLevel level)
+	{
+		static char* names[] = { "Scalar", "SSE2", "AVX2" };
+		return names[level];
+	}
+
+
+	static bool IsWhiteSpace(char c)
+	{ return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+	static bool IsIdentifier(char c)
+	{ return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$' || (c >= '0' && c <= '9'); }
+
+	static unsigned ScanWhiteSpaceScalar(char* data, unsigned pos, unsigned length, unsigned& newLines)
+	{
+		for (; pos < length && IsWhiteSpace(data[pos]); pos++)
+			if (data[pos] == '\n')
+				newLines++;
+		return pos;
+	}
+
+	static unsigned ScanIdentifierScalar(char* data, unsigned pos, unsigned length)
+	{
+		while (pos < length && IsIdentifier(data[pos]))
+			pos++;
+		return pos;
+	}
+
+	static unsigned ScanUntilScalar(char* data, unsigned pos, unsigned length, char c)
+	{
+		while (pos < length && data[pos] != c)
+			pos++;
+		return pos;
+	}
+
+	static void ScanLineStartsScalar(char* data, unsigned pos, unsigned length, std::vector<unsigned>& lineStarts)
+	{
+		for (; pos < length; pos++)
+			if (data[pos] == '\n')
+				lineStarts.push_back(pos + 1);
+	}
+
+
+#if __SY_SCAN_SIMD
+	static unsigned FirstBit(unsigned mask)
+	{
+#if _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	static unsigned CountBits(unsigned mask)
+	{
+		unsigned count = 0;
+		for (; mask; mask &= mask - 1)
+			count++;
+		return count;
+	}
+
+	static void PushLineStarts(unsigned mask, unsigned pos, std::vector<unsigned>& lineStarts)
+	{
+		for (; mask; mask &= mask - 1)
+			lineStarts.push_back(pos + FirstBit(mask) + 1);
+	}
+
+
+
+	// Blocks are only loaded while they fit, the next narrower scan finishes the tail
+	__SY_SCAN_TARGET("sse2")
+	static unsigned ScanWhiteSpaceSSE2(char* data, unsigned pos, unsigned length, unsigned& newLines)
+	{
+		const __m128i space = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'), cr = _mm_set1_epi8('\r'), lf = _mm_set1_epi8('\n');
+		for (; pos + 16 <= length; pos += 16)
+		{
+			__m128i block = _mm_loadu_si128((__m128i*)(data + pos));
+			__m128i isLf = _mm_cmpeq_epi8(block, lf);
+			__m128i isSpace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+				_mm_or_si128(_mm_cmpeq_epi8(block, cr), isLf));
+
+			unsigned stop = ~_mm_movemask_epi8(isSpace) & 0xFFFF;
+			unsigned lfMask = _mm_movemask_epi8(isLf);
+			if (stop)
+			{
+				newLines += CountBits(lfMask & ((1u << FirstBit(stop)) - 1));
+				return pos + FirstBit(stop);
+			}
+			newLines += CountBits(lfMask);
+		}
+
+		return ScanWhiteSpaceScalar(data, pos, length, newLines);
+	}
+
+	__SY_SCAN_TARGET("sse2")
+	static unsigned ScanIdentifierSSE2(char* data, unsigned pos, unsigned length)
+	{
+		// Setting 0x20 folds upper case onto lower case, bytes above 0x7F compare as negative and never match
+		const __m128i caseBit = _mm_set1_epi8(0x20);
+		const __m128i beforeA = _mm_set1_epi8('a' - 1), afterZ = _mm_set1_epi8('z' + 1);
+		const __m128i before0 = _mm_set1_epi8('0' - 1), after9 = _mm_set1_epi8('9' + 1);
+		const __m128i underscore = _mm_set1_epi8('_'), dollar = _mm_set1_epi8('$');
+		for (; pos + 16 <= length; pos += 16)
+		{
+			__m128i block = _mm_loadu_si128((__m128i*)(data + pos));
+			__m128i folded = _mm_or_si128(block, caseBit);
+			__m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(folded, beforeA), _mm_cmplt_epi8(folded, afterZ));
+			__m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(block, before0), _mm_cmplt_epi8(block, after9));
+			__m128i isIdentifier = _mm_or_si128(_mm_or_si128(isAlpha, isDigit),
+				_mm_or_si128(_mm_cmpeq_epi8(block, underscore), _mm_cmpeq_epi8(block, dollar)));
+
+			unsigned stop = ~_mm_movemask_epi8(isIdentifier) & 0xFFFF;
+			if (stop)
+				return pos + FirstBit(stop);
+		}
+
+		return ScanIdentifierScalar(data, pos, length);
+	}
+
+	__SY_SCAN_TARGET("sse2")
+	static unsigned ScanUntilSSE2(char* data, unsigned pos, unsigned length, char c)
+	{
+		const __m128i target = _mm_set1_epi8(c);
+		for (; pos + 16 <= length; pos += 16)
+		{
+			__m128i block = _mm_loadu_si128((__m128i*)(data + pos));
+			unsigned found = _mm_movemask_epi8(_mm_cmpeq_epi8(block, target));
+			if (found)
+				return pos + FirstBit(found);
+		}
+
+		return ScanUntilScalar(data, pos, length, c);
+	}
+
+	__SY_SCAN_TARGET("sse2")
+	static void ScanLineStartsSSE2(char* data, unsigned pos, unsigned length, std::vector<unsigned>& lineStarts)
+	{
+		const __m128i lf = _mm_set1_epi8('\n');
+		for (; pos + 16 <= length; pos += 16)
+		{
+			__m128i block = _mm_loadu_si128((__m128i*)(data + pos));
+			PushLineStarts(_mm_movemask_epi8(_mm_cmpeq_epi8(block, lf)), pos, lineStarts);
+		}
+
+		ScanLineStartsScalar(data, pos, length, lineStarts);
+	}
+
+
+	__SY_SCAN_TARGET("avx2")
+	static unsigned ScanWhiteSpaceAVX2(char* data, unsigned pos, unsigned length, unsigned& newLines)
+	{
+		const __m256i space = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t'), cr = _mm256_set1_epi8('\r'), lf = _mm256_set1_epi8('\n');
+		for (; pos + 32 <= length; pos += 32)
+		{
+			__m256i block = _mm256_loadu_si256((__m256i*)(data + pos));
+			__m256i isLf = _mm256_cmpeq_epi8(block, lf);
+			__m256i isSpace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(block, cr), isLf));
+
+			unsigned stop = ~(unsigned)_mm256_movemask_epi8(isSpace);
+			unsigned lfMask = _mm256_movemask_epi8(isLf);
+			if (stop)
+			{
+				newLines += CountBits(lfMask & ((1u << FirstBit(stop)) - 1));
+				return pos + FirstBit(stop);
+			}
+			newLines += CountBits(lfMask);
+		}
+
+		return ScanWhiteSpaceSSE2(data, pos, length, newLines);
+	}
+
+	__SY_SCAN_TARGET("avx2")
+	static unsigned ScanIdentifierAVX2(char* data, unsigned pos, unsigned length)
+	{
+		const __m256i caseBit = _mm256_set1_epi8(0x20);
+		const __m256i beforeA = _mm256_set1_epi8('a' - 1), afterZ = _mm256_set1_epi8('z' + 1);
+		const __m256i before0 = _mm256_set1_epi8('0' - 1), after9 = _mm256_set1_epi8('9' + 1);
+		const __m256i underscore = _mm256_set1_epi8('_'), dollar = _mm256_set1_epi8('$');
+		for (; pos + 32 <= length; pos += 32)
+		{
+			__m256i block = _mm256_loadu_si256((__m256i*)(data + pos));
+			__m256i folded = _mm256_or_si256(block, caseBit);
+			__m256i isAlpha = _mm256_and_si256(_mm256_cmpgt_epi8(folded, beforeA), _mm256_cmpgt_epi8(afterZ, folded));
+			__m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(block, before0), _mm256_cmpgt_epi8(after9, block));
+			__m256i isIdentifier = _mm256_or_si256(_mm256_or_si256(isAlpha, isDigit),
+				_mm256_or_si256(_mm256_cmpeq_epi8(block, underscore), _mm256_cmpeq_epi8(block, dollar)));
+
+			unsigned stop = ~(unsigned)_mm256_movemask_epi8(isIdentifier);
+			if (stop)
+				return pos + FirstBit(stop);
+		}
+
+		return ScanIdentifierSSE2(data, pos, length);
+	}
+
+	__SY_SCAN_TARGET("avx2")
+	static unsigned ScanUntilAVX2(char* data, unsigned pos, unsigned length, char c)
+	{
+		const __m256i target = _mm256_set1_epi8(c);
+		for (; pos + 32 <= length; pos += 32)
+		{
+			__m256i block = _mm256_loadu_si256((__m256i*)(data + pos));
+			unsigned found = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target));
+			if (found)
+				return pos + FirstBit(found);
+		}
+
+		return ScanUntilSSE2(data, pos, length, c);
+	}
+
+	__SY_SCAN_TARGET("avx2")
+	static void ScanLineStartsAVX2(char* data, unsigned pos, unsigned length, std::vector<unsigned>& lineStarts)
+	{
+		const __m256i lf = _mm256_set1_epi8('\n');
+		for (; pos + 32 <= length; pos += 32)
+		{
+			__m256i block = _mm256_loadu_si256((__m256i*)(data + pos));
+			PushLineStarts(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, lf)), pos, lineStarts);
+		}
+
+		ScanLineStartsSSE2(data, pos, length, lineStarts);
+	}
+#endif
+
+
+	unsigned ScanWhiteSpace(char* data, unsigned pos, unsigned length, unsigned& newLines)
+	{
+		newLines = 0;
+		switch (sScanLevel)
+		{
+#if __SY_SCAN_SIMD
+		case AVX2Scan:
+			return ScanWhiteSpaceAVX2(data, pos, length, newLines);
+		case SSE2Scan:
+			return ScanWhiteSpaceSSE2(data, pos, length, newLines);
+#endif
+		default:
+			return ScanWhiteSpaceScalar(data, pos, length, newLines);
+		}
+	}
+
+	unsigned ScanIdentifier(char* data, unsigned pos, unsigned length)
+	{
+		switch (sScanLevel)
+		{
+#if __SY_SCAN_SIMD
+		case AVX2Scan:
+			return ScanIdentifierAVX2(data, pos, length);
+		case SSE2Scan:
+			return ScanIdentifierSSE2(data, pos, length);
+#endif
+		default:
+			return ScanIdentifierScalar(data, pos, length);
+		}
+	}
+
+	unsigned ScanUntil(char* data, unsigned pos, unsigned length, char c)
+	{
+		switch (sScanLevel)
+		{
+#if __SY_SCAN_SIMD
+		case AVX2Scan:
+			return ScanUntilAVX2(data, pos, length, c);
+		case SSE2Scan:
+			return ScanUntilSSE2(data, pos, length, c);
+#endif
+		default:
+			return ScanUntilScalar(data, pos, length, c);
+		}
+	}
+
+	void ScanLineStarts(char* data, unsigned length, std::vector<unsigned>& lineStarts)
+	{
+		switch (sScanLevel)
+		{
+#if __SY_SCAN_SIMD
+		case AVX2Scan:
+			return ScanLineStartsAVX2(data, 0, length, lineStarts);
+		case SSE2Scan:
+			return ScanLineStartsSSE2(data, 0, length, lineStarts);
+#endif
+		default:
+			return ScanLineStartsScalar(data, 0, length, lineStarts);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "SympleCode/Util/ThreadPool.h"
+
+#include <atomic>
+#include <algorithm>
+
+namespace Symple::Util
+{
+	ThreadPool::ThreadPool(unsigned threadCount)
+	{
+		if (!threadCount)
+			threadCount = 1;
+		for (unsigned i = 0; i < threadCount; i++)
+			mThreads.emplace_back(&ThreadPool::Work, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mCondition.notify_all();
+
+		for (auto& thread : mThreads)
+			thread.join();
+	}
+
+
+	static std::atomic<uint64_t> sNextId = 1;
+	// The job running on this thread, or an id of its own outside of one
+	static thread_local uint64_t sCurrent = 0;
+
+	static uint64_t GetCurrent()
+	{
+		if (!sCurrent)
+			sCurrent = sNextId++;
+		return sCurrent;
+	}
+
+
+	void ThreadPool::Work()
+	{
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+				// Drain what is left before stopping so no future is left hanging
+				if (mJobs.empty())
+					return;
+
+				job = std::move(mJobs.front());
+				mJobs.pop_front();
+			}
+			Run(job);
+		}
+	}
+
+	void ThreadPool::Run(Job& job)
+	{
+		uint64_t previous = sCurrent;
+		sCurrent = job.Id;
+		job.Run();
+		sCurrent = previous;
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mFinished++;
+		}
+		mFinishedCondition.notify_all();
+	}
+
+	void ThreadPool::Push(std::function<void()> run)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mJobs.push_back({ std::move(run), GetCurrent(), sNextId++ });
+		}
+		mCondition.notify_one();
+	}
+
+	void ThreadPool::WaitUntil(std::function<bool()> ready)
+	{
+		uint64_t owner = GetCurrent();
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (true)
+		{
+			// Read before checking, so a job finishing in between still wakes the wait below
+			uint64_t finished = mFinished;
+			lock.unlock();
+			if (ready())
+				return;
+			lock.lock();
+
+			// Only this thread submits its own subtasks, so none can show up while it waits
+			auto own = std::find_if(mJobs.begin(), mJobs.end(), [owner](Job& job) { return job.Owner == owner; });
+			if (own == mJobs.end())
+			{
+				mFinishedCondition.wait(lock, [this, finished]() { return mFinished != finished; });
+				continue;
+			}
+
+			Job job = std::move(*own);
+			mJobs.erase(own);
+			lock.unlock();
+			Run(job);
+			lock.lock();
+		}
+	}
+
+
+	unsigned ThreadPool::GetThreadCount()
+	{ return mThreads.size(); }
+
+	ThreadPool& ThreadPool::Get()
+	{
+		static ThreadPool sPool;
+		return sPool;
+	}
+}
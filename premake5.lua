@@ -11,4 +11,5 @@ workspace "SympleCode"
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 include "SympleLang"
+include "SympleBench"
 -- include "SympleCompiler"
\ No newline at end of file